@@ -0,0 +1,117 @@
+#include "hand-gesture-recognition/async_gesture_classifier.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "absl/time/clock.h"
+
+namespace mediapipe {
+
+namespace {
+
+AsyncGestureClassifier::Frame MakeFrame(int max_num_hands, int feature_size) {
+  AsyncGestureClassifier::Frame frame;
+  frame.hand_ids.resize(max_num_hands);
+  frame.features.resize(max_num_hands * feature_size);
+  frame.classifications.resize(max_num_hands);
+  return frame;
+}
+
+}  // namespace
+
+AsyncGestureClassifier::AsyncGestureClassifier(
+    std::unique_ptr<GestureClassifier> classifier, int max_num_hands,
+    float min_confidence, float temperature)
+    : classifier_(std::move(classifier)),
+      max_num_hands_(max_num_hands),
+      min_confidence_(min_confidence),
+      temperature_(temperature),
+      frames_(MakeFrame(max_num_hands, classifier_->input_size())),
+      results_(MakeFrame(max_num_hands, classifier_->input_size())),
+      worker_([this] { Run(); }) {}
+
+AsyncGestureClassifier::~AsyncGestureClassifier() { Stop(); }
+
+bool AsyncGestureClassifier::Submit(int64_t* dropped_timestamp) {
+  const bool dropped = frames_.Publish();
+  if (dropped) {
+    *dropped_timestamp = frames_.writer_value()->timestamp;
+  }
+  // The mailbox needs no lock. Releasing the mutex only makes a parked
+  // worker re-check HasWork().
+  absl::MutexLock lock(&mutex_);
+  return dropped;
+}
+
+void AsyncGestureClassifier::Stop() {
+  {
+    absl::MutexLock lock(&mutex_);
+    stopping_ = true;
+  }
+  if (worker_.joinable()) {
+    worker_.join();
+  }
+}
+
+bool AsyncGestureClassifier::HasWork() const {
+  return stopping_ || frames_.HasFresh();
+}
+
+void AsyncGestureClassifier::Run() {
+  while (true) {
+    bool stopping;
+    {
+      absl::MutexLock lock(&mutex_);
+      mutex_.Await(absl::Condition(this, &AsyncGestureClassifier::HasWork));
+      stopping = stopping_;
+    }
+    const Frame* frame = frames_.Take();
+    if (frame != nullptr) {
+      Classify(*frame, results_.writer_value());
+      results_.Publish();
+    } else if (stopping) {
+      return;
+    }
+  }
+}
+
+void AsyncGestureClassifier::Classify(const Frame& frame, Frame* result) {
+  result->timestamp = frame.timestamp;
+  result->num_input_hands = frame.num_input_hands;
+  result->num_hands = frame.num_hands;
+  std::copy_n(frame.hand_ids.begin(), frame.num_hands,
+              result->hand_ids.begin());
+  result->invoke_ns = 0;
+  result->postprocessing_ns = 0;
+  result->status = ::mediapipe::OkStatus();
+  if (frame.num_hands == 0) {
+    return;
+  }
+
+  result->status = classifier_->ResizeBatch(frame.num_hands);
+  if (!result->status.ok()) {
+    return;
+  }
+  std::copy_n(frame.features.begin(),
+              frame.num_hands * classifier_->input_size(),
+              classifier_->input());
+  int64_t start_ns = absl::GetCurrentTimeNanos();
+  result->status = classifier_->Invoke();
+  result->invoke_ns = absl::GetCurrentTimeNanos() - start_ns;
+  if (!result->status.ok()) {
+    return;
+  }
+
+  start_ns = absl::GetCurrentTimeNanos();
+  const float* output = classifier_->output();
+  const int num_classes = classifier_->num_classes();
+  for (int k = 0; k < frame.num_hands; ++k) {
+    GestureClassification& classification = result->classifications[k];
+    FillGestureClassification(output + k * num_classes, num_classes,
+                              min_confidence_, &classification, temperature_);
+    classification.hand_id = frame.hand_ids[k];
+  }
+  result->postprocessing_ns = absl::GetCurrentTimeNanos() - start_ns;
+}
+
+}  // namespace mediapipe
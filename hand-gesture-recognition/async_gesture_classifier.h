@@ -0,0 +1,94 @@
+#ifndef HAND_GESTURE_RECOGNITION_ASYNC_GESTURE_CLASSIFIER_H_
+#define HAND_GESTURE_RECOGNITION_ASYNC_GESTURE_CLASSIFIER_H_
+
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "absl/synchronization/mutex.h"
+#include "hand-gesture-recognition/gesture_classification.h"
+#include "hand-gesture-recognition/gesture_classifier.h"
+#include "hand-gesture-recognition/latest_value_mailbox.h"
+#include "mediapipe/framework/port/status.h"
+
+namespace mediapipe {
+
+// Runs a GestureClassifier on a dedicated worker thread.
+//
+// The caller fills input_frame() with the features of a frame and submits
+// it. Frames travel to the worker and results back through
+// LatestValueMailboxes: when the worker is busy, a newer frame replaces the
+// waiting one, which is dropped. Results come back in submission order. All
+// buffers are sized in the constructor, steady-state frames do not allocate.
+class AsyncGestureClassifier {
+ public:
+  // A frame on its way to the worker, then its result on the way back.
+  struct Frame {
+    int64_t timestamp = 0;
+    // Hands in the frame, and how many of them were classified.
+    int num_input_hands = 0;
+    int num_hands = 0;
+    // Per classified hand: its index among the input hands, its
+    // GestureClassifier::input_size() features and, in results, its
+    // classification.
+    std::vector<int> hand_ids;
+    std::vector<float> features;
+    std::vector<GestureClassification> classifications;
+    // Set by the worker.
+    int64_t invoke_ns = 0;
+    int64_t postprocessing_ns = 0;
+    ::mediapipe::Status status;
+  };
+
+  AsyncGestureClassifier(std::unique_ptr<GestureClassifier> classifier,
+                         int max_num_hands, float min_confidence,
+                         float temperature = 1.f);
+  // Finishes the frame in progress and joins the worker.
+  ~AsyncGestureClassifier();
+
+  AsyncGestureClassifier(const AsyncGestureClassifier&) = delete;
+  AsyncGestureClassifier& operator=(const AsyncGestureClassifier&) = delete;
+
+  int max_num_hands() const { return max_num_hands_; }
+
+  // The frame to fill before Submit().
+  Frame* input_frame() { return frames_.writer_value(); }
+
+  // Queues input_frame() for the worker. Returns true if it replaced a frame
+  // the worker had not started; `dropped_timestamp` is then that frame's.
+  bool Submit(int64_t* dropped_timestamp);
+
+  // The latest result, nullptr if none arrived since the last call. Earlier
+  // unclaimed results are dropped. Valid until the next call.
+  const Frame* TakeResult() { return results_.Take(); }
+
+  // Waits for the queued frames to be classified and stops the worker.
+  // TakeResult() still returns the last result afterwards.
+  void Stop();
+
+ private:
+  void Run();
+  // Whether the worker has a frame to classify or should stop. Called with
+  // `mutex_` held.
+  bool HasWork() const;
+  void Classify(const Frame& frame, Frame* result);
+
+  std::unique_ptr<GestureClassifier> classifier_;
+  const int max_num_hands_;
+  const float min_confidence_;
+  const float temperature_;
+
+  LatestValueMailbox<Frame> frames_;
+  LatestValueMailbox<Frame> results_;
+
+  // Only used to park the worker while there is nothing to classify.
+  absl::Mutex mutex_;
+  bool stopping_ = false;
+
+  std::thread worker_;
+};
+
+}  // namespace mediapipe
+
+#endif  // HAND_GESTURE_RECOGNITION_ASYNC_GESTURE_CLASSIFIER_H_
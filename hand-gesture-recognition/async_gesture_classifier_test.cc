@@ -0,0 +1,163 @@
+#include "hand-gesture-recognition/async_gesture_classifier.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <set>
+#include <vector>
+
+#include "hand-gesture-recognition/gesture_classification.h"
+#include "hand-gesture-recognition/gesture_classifier.h"
+#include "mediapipe/framework/port/gtest.h"
+#include "mediapipe/framework/port/status_matchers.h"
+
+namespace mediapipe {
+namespace {
+
+constexpr char kModelPath[] = "mediapipe/models/model_targeted_a.tflite";
+constexpr int kMaxNumHands = 2;
+constexpr int kNumFrames = 500;
+constexpr float kMinConfidence = 0.5f;
+
+struct TestFrame {
+  int num_hands;
+  std::vector<float> features;
+  std::vector<GestureClassification> expected;
+};
+
+std::unique_ptr<GestureClassifier> CreateClassifier() {
+  auto classifier =
+      GestureClassifier::Create(kModelPath, GestureClassifier::Options());
+  MP_EXPECT_OK(classifier.status());
+  if (!classifier.ok()) return nullptr;
+  return std::move(classifier).ValueOrDie();
+}
+
+// Frames of one or two hands with random features, and their
+// classifications by a classifier run synchronously.
+std::vector<TestFrame> MakeFrames(GestureClassifier* classifier) {
+  std::mt19937 random(1);
+  std::uniform_real_distribution<float> feature(-0.3f, 0.3f);
+  const int input_size = classifier->input_size();
+  const int num_classes = classifier->num_classes();
+  std::vector<TestFrame> frames(kNumFrames);
+  for (int t = 0; t < kNumFrames; ++t) {
+    TestFrame& frame = frames[t];
+    frame.num_hands = 1 + t % kMaxNumHands;
+    frame.features.resize(frame.num_hands * input_size);
+    for (float& value : frame.features) value = feature(random);
+
+    MP_EXPECT_OK(classifier->ResizeBatch(frame.num_hands));
+    std::copy(frame.features.begin(), frame.features.end(),
+              classifier->input());
+    MP_EXPECT_OK(classifier->Invoke());
+    frame.expected.resize(frame.num_hands);
+    for (int k = 0; k < frame.num_hands; ++k) {
+      FillGestureClassification(classifier->output() + k * num_classes,
+                                num_classes, kMinConfidence,
+                                &frame.expected[k]);
+      frame.expected[k].hand_id = k;
+    }
+  }
+  return frames;
+}
+
+void ExpectResultOf(const AsyncGestureClassifier::Frame& result,
+                    const std::vector<TestFrame>& frames) {
+  MP_ASSERT_OK(result.status);
+  ASSERT_GE(result.timestamp, 0);
+  ASSERT_LT(result.timestamp, kNumFrames);
+  const TestFrame& frame = frames[result.timestamp];
+  ASSERT_EQ(result.num_hands, frame.num_hands) << "frame " << result.timestamp;
+  ASSERT_EQ(result.num_input_hands, frame.num_hands);
+  // A result mixing two frames would show the labels or scores of another
+  // frame for some hand.
+  for (int k = 0; k < frame.num_hands; ++k) {
+    const GestureClassification& actual = result.classifications[k];
+    const GestureClassification& expected = frame.expected[k];
+    EXPECT_EQ(result.hand_ids[k], k);
+    EXPECT_EQ(actual.hand_id, expected.hand_id);
+    EXPECT_EQ(actual.label, expected.label) << "frame " << result.timestamp;
+    ASSERT_EQ(actual.num_classes, expected.num_classes);
+    for (int c = 0; c < actual.num_classes; ++c) {
+      EXPECT_FLOAT_EQ(actual.probabilities[c], expected.probabilities[c])
+          << "frame " << result.timestamp << " hand " << k << " class " << c;
+    }
+  }
+}
+
+TEST(AsyncGestureClassifierTest, LatestFrameWinsWithoutTornResults) {
+  std::unique_ptr<GestureClassifier> reference = CreateClassifier();
+  ASSERT_NE(reference, nullptr);
+  const std::vector<TestFrame> frames = MakeFrames(reference.get());
+  std::unique_ptr<GestureClassifier> model = CreateClassifier();
+  ASSERT_NE(model, nullptr);
+  AsyncGestureClassifier classifier(std::move(model), kMaxNumHands,
+                                    kMinConfidence);
+
+  std::set<int64_t> dropped;
+  std::set<int64_t> resolved;
+  int64_t last_result = -1;
+  auto take_result = [&]() {
+    const AsyncGestureClassifier::Frame* result = classifier.TakeResult();
+    if (result == nullptr) return;
+    // Results come back in submission order.
+    EXPECT_GT(result->timestamp, last_result);
+    last_result = result->timestamp;
+    resolved.insert(result->timestamp);
+    ExpectResultOf(*result, frames);
+  };
+
+  // Frames are submitted as fast as possible, so the worker falls behind
+  // and waiting frames get replaced.
+  for (int t = 0; t < kNumFrames; ++t) {
+    AsyncGestureClassifier::Frame* input = classifier.input_frame();
+    input->timestamp = t;
+    input->num_input_hands = frames[t].num_hands;
+    input->num_hands = frames[t].num_hands;
+    for (int k = 0; k < frames[t].num_hands; ++k) input->hand_ids[k] = k;
+    std::copy(frames[t].features.begin(), frames[t].features.end(),
+              input->features.begin());
+    int64_t dropped_timestamp = -1;
+    if (classifier.Submit(&dropped_timestamp)) {
+      EXPECT_LT(dropped_timestamp, t);
+      EXPECT_TRUE(dropped.insert(dropped_timestamp).second);
+    }
+    take_result();
+  }
+  classifier.Stop();
+  take_result();
+
+  // Stop() classifies the frame still queued, so the last frame is never
+  // lost, and no dropped frame comes back as a result.
+  EXPECT_EQ(last_result, kNumFrames - 1);
+  for (int64_t timestamp : dropped) {
+    EXPECT_EQ(resolved.count(timestamp), 0u) << "frame " << timestamp;
+  }
+}
+
+TEST(AsyncGestureClassifierTest, FrameWithoutHandsSkipsInvoke) {
+  std::unique_ptr<GestureClassifier> model = CreateClassifier();
+  ASSERT_NE(model, nullptr);
+  AsyncGestureClassifier classifier(std::move(model), kMaxNumHands,
+                                    kMinConfidence);
+  AsyncGestureClassifier::Frame* input = classifier.input_frame();
+  input->timestamp = 7;
+  input->num_input_hands = 0;
+  input->num_hands = 0;
+  int64_t dropped_timestamp;
+  EXPECT_FALSE(classifier.Submit(&dropped_timestamp));
+  classifier.Stop();
+
+  const AsyncGestureClassifier::Frame* result = classifier.TakeResult();
+  ASSERT_NE(result, nullptr);
+  MP_EXPECT_OK(result->status);
+  EXPECT_EQ(result->timestamp, 7);
+  EXPECT_EQ(result->num_hands, 0);
+  EXPECT_EQ(result->invoke_ns, 0);
+  EXPECT_EQ(classifier.TakeResult(), nullptr);
+}
+
+}  // namespace
+}  // namespace mediapipe
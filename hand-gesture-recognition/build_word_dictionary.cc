@@ -0,0 +1,80 @@
+// Builds the word dictionary of WordAssemblyCalculator from a word list.
+//
+// The word list has one word per line, optionally followed by whitespace and
+// its frequency (1 when missing). Words are upper-cased; lines starting with
+// '#' are ignored.
+//
+// bazel run -c opt //hand-gesture-recognition:build_word_dictionary -- \
+//   --word_list=/path/to/words.txt \
+//   --output_path=mediapipe/models/asl_words.dict
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "hand-gesture-recognition/word_dictionary.h"
+#include "mediapipe/framework/port/commandlineflags.h"
+#include "mediapipe/framework/port/logging.h"
+#include "mediapipe/framework/port/ret_check.h"
+#include "mediapipe/framework/port/status.h"
+
+DEFINE_string(word_list, "", "Word list, one word and frequency per line.");
+DEFINE_string(output_path, "", "Where to write the dictionary.");
+
+namespace mediapipe {
+
+namespace {
+
+::mediapipe::Status RunBuilder() {
+  RET_CHECK(!FLAGS_word_list.empty()) << "--word_list is required.";
+  RET_CHECK(!FLAGS_output_path.empty()) << "--output_path is required.";
+
+  std::ifstream input(FLAGS_word_list);
+  RET_CHECK(input) << "Failed to open " << FLAGS_word_list;
+  std::vector<std::pair<std::string, uint32_t>> words;
+  std::string line;
+  int line_number = 0;
+  while (std::getline(input, line)) {
+    ++line_number;
+    std::istringstream fields(line);
+    std::string word;
+    if (!(fields >> word) || word[0] == '#') continue;
+    long long frequency = 1;
+    if (!(fields >> std::ws).eof()) {
+      RET_CHECK(fields >> frequency && frequency >= 0 &&
+                frequency <= 0xffffffffll)
+          << FLAGS_word_list << ":" << line_number << ": bad frequency.";
+    }
+    words.emplace_back(word, static_cast<uint32_t>(frequency));
+  }
+
+  std::string image;
+  MP_RETURN_IF_ERROR(BuildWordDictionary(words, &image));
+  std::ofstream output(FLAGS_output_path, std::ios::binary);
+  RET_CHECK(output.write(image.data(), image.size()))
+      << "Failed to write " << FLAGS_output_path;
+  std::printf("%zu words, %zu nodes, %zu bytes\n", words.size(),
+              (image.size() - sizeof(WordDictionaryHeader)) /
+                  sizeof(WordDictionaryNode),
+              image.size());
+  return ::mediapipe::OkStatus();
+}
+
+}  // namespace
+
+}  // namespace mediapipe
+
+int main(int argc, char** argv) {
+  google::InitGoogleLogging(argv[0]);
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+  const ::mediapipe::Status status = ::mediapipe::RunBuilder();
+  if (!status.ok()) {
+    LOG(ERROR) << "Failed to build the dictionary: " << status.message();
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
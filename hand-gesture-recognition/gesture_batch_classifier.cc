@@ -0,0 +1,357 @@
+// Classifies every sample of a landmark dataset with the letter classifier,
+// for re-scoring recorded poses after retraining. landmark_log_to_dataset
+// makes datasets from recorded landmark logs.
+//
+// The dataset is memory-mapped and cut into chunks of --batch_size samples.
+// Each of the --num_workers threads owns its own GestureClassifier, sized for
+// one chunk, and pulls chunks off a shared counter until none are left, so
+// the workers share nothing but the read-only mapping and scale with the
+// number of cores. Features are those of HandGestureRecognitionCalculator,
+// the z-scores or, with --features=invariant, the invariant features with
+// the rotation taken from the landmarks, as the dataset has no rects. Labels
+// follow the same min_confidence rule and confidence calibration, and come
+// from --label_map_path or --labels as in GetGestureLabels.
+//
+// Writes one "sample,label,prediction,confidence" line per sample to
+// --predictions_path and, over the labeled samples, the confusion matrix to
+// --confusion_matrix_path: one row per true label, one column per predicted
+// label plus "?" for predictions below --min_confidence.
+//
+// Example, with the flags on one line:
+//
+//   bazel run -c opt //hand-gesture-recognition:gesture_batch_classifier --
+//     --model_path=mediapipe/models/model_targeted_a.tflite
+//     --dataset=/path/to/poses.hgds
+//     --predictions_path=/tmp/predictions.csv
+//     --confusion_matrix_path=/tmp/confusion.csv
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
+#include "hand-gesture-recognition/gesture_classification.h"
+#include "hand-gesture-recognition/gesture_classifier.h"
+#include "hand-gesture-recognition/gesture_label_map.h"
+#include "hand-gesture-recognition/landmark_dataset.h"
+#include "hand-gesture-recognition/landmark_features.h"
+#include "mediapipe/framework/port/commandlineflags.h"
+#include "mediapipe/framework/port/logging.h"
+#include "mediapipe/framework/port/ret_check.h"
+#include "mediapipe/framework/port/status.h"
+
+DEFINE_string(model_path, "mediapipe/models/model_targeted_a.tflite",
+              "Letter classifier.");
+DEFINE_string(dataset, "", "Landmark dataset to classify.");
+DEFINE_string(predictions_path, "",
+              "Where to write the per-sample predictions, as CSV. Skipped "
+              "when empty.");
+DEFINE_string(confusion_matrix_path, "",
+              "Where to write the confusion matrix, as CSV. Printed when "
+              "empty.");
+DEFINE_string(labels, "ABCDEFGHIKLMNOPQRSTUVWXY",
+              "One character per classifier output, in output order. "
+              "Ignored when --label_map_path is set.");
+DEFINE_string(label_map_path, "",
+              "Label map of the classifier, one label per line.");
+DEFINE_double(min_confidence, 0.3,
+              "Predictions below this calibrated probability are reported "
+              "as \"?\".");
+DEFINE_double(confidence_temperature, 1.0,
+              "Temperature of the confidence calibration, as in "
+              "HandGestureRecognitionCalculatorOptions.");
+DEFINE_int32(num_workers, 0,
+             "Classifier threads. 0 uses one per hardware thread.");
+DEFINE_int32(batch_size, 256, "Samples per Invoke.");
+DEFINE_bool(xnnpack, true, "Run the classifier on the XNNPACK delegate.");
+DEFINE_string(features, "zscore",
+              "Classifier input, \"zscore\" or \"invariant\", as the "
+              "features option of HandGestureRecognitionCalculatorOptions.");
+DEFINE_double(aspect_ratio, 1.0,
+              "Width over height of the images the poses were recorded "
+              "from, for --features=invariant.");
+
+namespace mediapipe {
+
+namespace {
+
+// Everything a worker produces besides the predictions themselves.
+struct WorkerResult {
+  ::mediapipe::Status status;
+  // Row-major, num_classes rows of num_classes + 1 columns, the last one for
+  // unknown predictions.
+  std::vector<int64_t> confusion;
+  int64_t num_samples = 0;
+};
+
+GestureClassifier::Options ClassifierOptions(int feature_size) {
+  GestureClassifier::Options options;
+  options.delegate = FLAGS_xnnpack ? GestureClassifier::Delegate::kXnnpack
+                                   : GestureClassifier::Delegate::kNone;
+  // Parallelism comes from the workers, one thread per interpreter.
+  options.num_threads = 1;
+  options.feature_size = feature_size;
+  return options;
+}
+
+class BatchClassifier {
+ public:
+  BatchClassifier(const LandmarkDataset& dataset, int num_classes,
+                  bool invariant_features)
+      : dataset_(dataset),
+        num_classes_(num_classes),
+        invariant_features_(invariant_features),
+        feature_size_(invariant_features ? kInvariantFeatureSize
+                                         : kZScoreFeatureSize),
+        num_chunks_((dataset.num_samples() + FLAGS_batch_size - 1) /
+                    FLAGS_batch_size),
+        predictions_(dataset.num_samples()),
+        confidences_(dataset.num_samples()) {}
+
+  // Classifies the whole dataset on `num_workers` threads.
+  ::mediapipe::Status Run(int num_workers) {
+    results_.resize(num_workers);
+    std::vector<std::thread> workers;
+    workers.reserve(num_workers);
+    for (int w = 0; w < num_workers; ++w) {
+      workers.emplace_back([this, w] { RunWorker(&results_[w]); });
+    }
+    for (auto& worker : workers) {
+      worker.join();
+    }
+    for (const auto& result : results_) {
+      MP_RETURN_IF_ERROR(result.status);
+    }
+    return ::mediapipe::OkStatus();
+  }
+
+  const std::vector<WorkerResult>& results() const { return results_; }
+  int prediction(int64_t sample) const { return predictions_[sample]; }
+  float confidence(int64_t sample) const { return confidences_[sample]; }
+
+ private:
+  void RunWorker(WorkerResult* result) {
+    result->confusion.assign(num_classes_ * (num_classes_ + 1), 0);
+    result->status = ClassifyChunks(result);
+    if (!result->status.ok()) {
+      // Let the other workers run out of chunks.
+      next_chunk_.store(num_chunks_);
+    }
+  }
+
+  ::mediapipe::Status ClassifyChunks(WorkerResult* result) {
+    std::unique_ptr<GestureClassifier> classifier;
+    ASSIGN_OR_RETURN(classifier,
+                     GestureClassifier::Create(
+                         FLAGS_model_path, ClassifierOptions(feature_size_)));
+    RET_CHECK_EQ(classifier->num_classes(), num_classes_);
+    // The last chunk is zero-padded rather than resized, so the tensors are
+    // allocated once per worker.
+    MP_RETURN_IF_ERROR(classifier->ResizeBatch(FLAGS_batch_size));
+
+    HandLandmarksSoA hand;
+    GestureClassification classification;
+    int64_t chunk;
+    while ((chunk = next_chunk_.fetch_add(1)) < num_chunks_) {
+      const int64_t begin = chunk * FLAGS_batch_size;
+      const int count = static_cast<int>(
+          std::min<int64_t>(FLAGS_batch_size, dataset_.num_samples() - begin));
+      float* input = classifier->input();
+      for (int k = 0; k < count; ++k) {
+        dataset_.GetHand(begin + k, &hand);
+        float* features = input + k * feature_size_;
+        if (invariant_features_) {
+          const float aspect_ratio = FLAGS_aspect_ratio;
+          ComputeInvariantFeatures(
+              hand, HandRotationFromLandmarks(hand, aspect_ratio),
+              aspect_ratio, features);
+        } else {
+          ComputeZScoreFeatures(hand, features);
+        }
+      }
+      std::fill(input + count * feature_size_,
+                input + FLAGS_batch_size * feature_size_, 0.f);
+      MP_RETURN_IF_ERROR(classifier->Invoke());
+
+      const float* output = classifier->output();
+      for (int k = 0; k < count; ++k) {
+        const int64_t sample = begin + k;
+        FillGestureClassification(output + k * num_classes_, num_classes_,
+                                  FLAGS_min_confidence, &classification,
+                                  FLAGS_confidence_temperature);
+        predictions_[sample] = classification.label;
+        confidences_[sample] = classification.confidence;
+        const int32_t label = dataset_.label(sample);
+        if (label != kUnlabeledSample) {
+          const int column = classification.label >= 0 ? classification.label
+                                                       : num_classes_;
+          ++result->confusion[label * (num_classes_ + 1) + column];
+        }
+      }
+      result->num_samples += count;
+    }
+    return ::mediapipe::OkStatus();
+  }
+
+  const LandmarkDataset& dataset_;
+  const int num_classes_;
+  const bool invariant_features_;
+  const int feature_size_;
+  const int64_t num_chunks_;
+  std::atomic<int64_t> next_chunk_{0};
+  // Written by whichever worker owns the chunk, so without locking.
+  std::vector<int8_t> predictions_;
+  std::vector<float> confidences_;
+  std::vector<WorkerResult> results_;
+};
+
+// `labels` holds the text of every classifier output.
+const char* LabelText(const std::vector<std::string>& labels, int label) {
+  return label >= 0 ? labels[label].c_str() : "?";
+}
+
+::mediapipe::Status WritePredictions(const LandmarkDataset& dataset,
+                                     const BatchClassifier& classifier,
+                                     const std::vector<std::string>& labels) {
+  std::FILE* file = std::fopen(FLAGS_predictions_path.c_str(), "w");
+  RET_CHECK(file) << "Cannot open " << FLAGS_predictions_path;
+  std::fprintf(file, "sample,label,prediction,confidence\n");
+  for (int64_t i = 0; i < dataset.num_samples(); ++i) {
+    const int32_t label = dataset.label(i);
+    std::fprintf(file, "%lld,%s,%s,%.4f\n", static_cast<long long>(i),
+                 label == kUnlabeledSample ? "-" : LabelText(labels, label),
+                 LabelText(labels, classifier.prediction(i)),
+                 classifier.confidence(i));
+  }
+  const bool ok = std::fclose(file) == 0;
+  RET_CHECK(ok) << "Failed to write " << FLAGS_predictions_path;
+  return ::mediapipe::OkStatus();
+}
+
+::mediapipe::Status WriteConfusionMatrix(const std::vector<int64_t>& matrix,
+                                         const std::vector<std::string>& labels,
+                                         int num_classes) {
+  std::FILE* file = FLAGS_confusion_matrix_path.empty()
+                        ? stdout
+                        : std::fopen(FLAGS_confusion_matrix_path.c_str(), "w");
+  RET_CHECK(file) << "Cannot open " << FLAGS_confusion_matrix_path;
+  std::fprintf(file, "label");
+  for (int c = 0; c <= num_classes; ++c) {
+    std::fprintf(file, ",%s", LabelText(labels, c < num_classes ? c : -1));
+  }
+  std::fprintf(file, "\n");
+  for (int row = 0; row < num_classes; ++row) {
+    std::fprintf(file, "%s", LabelText(labels, row));
+    for (int c = 0; c <= num_classes; ++c) {
+      std::fprintf(file, ",%lld",
+                   static_cast<long long>(matrix[row * (num_classes + 1) + c]));
+    }
+    std::fprintf(file, "\n");
+  }
+  if (file != stdout) {
+    const bool ok = std::fclose(file) == 0;
+    RET_CHECK(ok) << "Failed to write " << FLAGS_confusion_matrix_path;
+  }
+  return ::mediapipe::OkStatus();
+}
+
+::mediapipe::Status RunBatchClassifier() {
+  RET_CHECK(!FLAGS_dataset.empty()) << "--dataset is required.";
+  RET_CHECK_GT(FLAGS_batch_size, 0);
+  RET_CHECK_GT(FLAGS_confidence_temperature, 0.);
+  RET_CHECK(FLAGS_features == "zscore" || FLAGS_features == "invariant")
+      << "Unknown --features " << FLAGS_features;
+  RET_CHECK_GT(FLAGS_aspect_ratio, 0.);
+  const bool invariant_features = FLAGS_features == "invariant";
+  int num_classes;
+  {
+    // Only for the number of outputs; the workers create their own.
+    std::unique_ptr<GestureClassifier> classifier;
+    ASSIGN_OR_RETURN(
+        classifier,
+        GestureClassifier::Create(
+            FLAGS_model_path,
+            ClassifierOptions(invariant_features ? kInvariantFeatureSize
+                                                 : kZScoreFeatureSize)));
+    num_classes = classifier->num_classes();
+  }
+  RET_CHECK(num_classes > 0 && num_classes <= kMaxGestureClasses)
+      << FLAGS_model_path << " must have 1 to " << kMaxGestureClasses
+      << " outputs.";
+  std::vector<std::string> labels;
+  MP_RETURN_IF_ERROR(GetGestureLabels(FLAGS_label_map_path, FLAGS_labels,
+                                      num_classes, &labels));
+
+  std::unique_ptr<LandmarkDataset> dataset;
+  ASSIGN_OR_RETURN(dataset, LandmarkDataset::Open(FLAGS_dataset));
+  RET_CHECK_GT(dataset->num_samples(), 0) << FLAGS_dataset << " is empty.";
+  // Only the label column is read here.
+  int64_t num_labeled = 0;
+  for (int64_t i = 0; i < dataset->num_samples(); ++i) {
+    const int32_t label = dataset->label(i);
+    RET_CHECK(label == kUnlabeledSample || (label >= 0 && label < num_classes))
+        << "Sample " << i << " has label " << label
+        << ", not a classifier output.";
+    num_labeled += label != kUnlabeledSample;
+  }
+
+  int num_workers = FLAGS_num_workers;
+  if (num_workers <= 0) {
+    num_workers = std::max(1u, std::thread::hardware_concurrency());
+  }
+  BatchClassifier classifier(*dataset, num_classes, invariant_features);
+  const absl::Time start = absl::Now();
+  MP_RETURN_IF_ERROR(classifier.Run(num_workers));
+  const double seconds = absl::ToDoubleSeconds(absl::Now() - start);
+
+  std::vector<int64_t> confusion(num_classes * (num_classes + 1), 0);
+  for (const auto& result : classifier.results()) {
+    for (size_t i = 0; i < confusion.size(); ++i) {
+      confusion[i] += result.confusion[i];
+    }
+  }
+  int64_t correct = 0;
+  for (int label = 0; label < num_classes; ++label) {
+    correct += confusion[label * (num_classes + 1) + label];
+  }
+
+  std::printf("%lld samples, %d workers, batch %d: %.2f s, %.0f samples/s\n",
+              static_cast<long long>(dataset->num_samples()), num_workers,
+              FLAGS_batch_size, seconds, dataset->num_samples() / seconds);
+  for (int w = 0; w < num_workers; ++w) {
+    std::printf("  worker %d: %lld samples\n", w,
+                static_cast<long long>(classifier.results()[w].num_samples));
+  }
+  if (num_labeled > 0) {
+    std::printf("accuracy %.2f%% over %lld labeled samples\n",
+                100. * correct / num_labeled,
+                static_cast<long long>(num_labeled));
+    MP_RETURN_IF_ERROR(WriteConfusionMatrix(confusion, labels, num_classes));
+  }
+  if (!FLAGS_predictions_path.empty()) {
+    MP_RETURN_IF_ERROR(WritePredictions(*dataset, classifier, labels));
+  }
+  return ::mediapipe::OkStatus();
+}
+
+}  // namespace
+
+}  // namespace mediapipe
+
+int main(int argc, char** argv) {
+  google::InitGoogleLogging(argv[0]);
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+  const ::mediapipe::Status status = ::mediapipe::RunBatchClassifier();
+  if (!status.ok()) {
+    LOG(ERROR) << "Failed to classify the dataset: " << status.message();
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,267 @@
+// Replays a landmark log through HandGestureRecognitionCalculator,
+// ZScoreCalculator and StringToRenderDataCalculator on the CPU and reports,
+// for each of them, the p50/p99 latency per frame, the heap allocations per
+// frame and the throughput.
+//
+// Each calculator runs alone in its own CalculatorGraph, so the numbers are
+// not mixed up with the other nodes. Latency is measured from adding a frame
+// to the graph until the graph is idle again, one frame at a time, and
+// includes the scheduler overhead. Throughput is measured in a second run
+// that queues all frames at once. Allocations are counted by the global
+// operator new of this binary over the latency run, input packets are built
+// beforehand and are not counted.
+//
+// Without --landmark_log, a synthetic log is generated (see
+// GenerateSyntheticLandmarkLog), so no camera or GPU is needed:
+//
+// bazel run -c opt //hand-gesture-recognition:gesture_calculators_benchmark -- \
+//   --model_path=mediapipe/models/model_targeted_a.tflite
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "absl/strings/str_cat.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
+#include "hand-gesture-recognition/gesture_rules.h"
+#include "hand-gesture-recognition/landmark_features.h"
+#include "hand-gesture-recognition/landmark_log.h"
+#include "mediapipe/framework/calculator_framework.h"
+#include "mediapipe/framework/formats/landmark.pb.h"
+#include "mediapipe/framework/formats/rect.pb.h"
+#include "mediapipe/framework/port/commandlineflags.h"
+#include "mediapipe/framework/port/logging.h"
+#include "mediapipe/framework/port/parse_text_proto.h"
+#include "mediapipe/framework/port/ret_check.h"
+#include "mediapipe/framework/port/status.h"
+
+DEFINE_string(landmark_log, "",
+              "Landmark log to replay. A synthetic log is used when empty.");
+DEFINE_int32(synthetic_frames, 3000,
+             "Number of frames of the synthetic log.");
+DEFINE_int32(synthetic_seed, 1, "Seed of the synthetic log.");
+DEFINE_string(write_synthetic_log, "",
+              "If set, writes the synthetic log to this path and exits.");
+DEFINE_string(model_path, "mediapipe/models/model_targeted_a.tflite",
+              "Letter classifier used by HandGestureRecognitionCalculator.");
+
+namespace {
+
+std::atomic<int64_t> allocation_count(0);
+
+}  // namespace
+
+void* operator new(std::size_t size) {
+  allocation_count.fetch_add(1, std::memory_order_relaxed);
+  if (void* p = std::malloc(size == 0 ? 1 : size)) return p;
+  throw std::bad_alloc();
+}
+void* operator new[](std::size_t size) { return operator new(size); }
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+
+namespace mediapipe {
+
+namespace {
+
+// Input packets of one graph input stream, one per frame.
+struct StreamInput {
+  std::string stream;
+  std::vector<Packet> packets;
+};
+
+struct BenchmarkResult {
+  std::string calculator;
+  int frames = 0;
+  double p50_us = 0;
+  double p99_us = 0;
+  double allocations_per_frame = 0;
+  double frames_per_second = 0;
+};
+
+double Percentile(std::vector<double> values, double fraction) {
+  if (values.empty()) return 0;
+  const size_t index = std::min(values.size() - 1,
+                                static_cast<size_t>(fraction * values.size()));
+  std::nth_element(values.begin(), values.begin() + index, values.end());
+  return values[index];
+}
+
+::mediapipe::Status AddFrame(const std::vector<StreamInput>& inputs, int frame,
+                             CalculatorGraph* graph) {
+  for (const auto& input : inputs) {
+    MP_RETURN_IF_ERROR(
+        graph->AddPacketToInputStream(input.stream, input.packets[frame]));
+  }
+  return ::mediapipe::OkStatus();
+}
+
+::mediapipe::Status RunBenchmark(const std::string& calculator,
+                                 const CalculatorGraphConfig& config,
+                                 const std::vector<StreamInput>& inputs,
+                                 BenchmarkResult* result) {
+  const int num_frames = inputs.front().packets.size();
+  result->calculator = calculator;
+  result->frames = num_frames;
+
+  // Latency and allocations, one frame at a time.
+  {
+    CalculatorGraph graph;
+    MP_RETURN_IF_ERROR(graph.Initialize(config));
+    MP_RETURN_IF_ERROR(graph.StartRun({}));
+    std::vector<double> latencies_us;
+    latencies_us.reserve(num_frames);
+    const int64_t allocations_before = allocation_count.load();
+    for (int frame = 0; frame < num_frames; ++frame) {
+      const absl::Time start = absl::Now();
+      MP_RETURN_IF_ERROR(AddFrame(inputs, frame, &graph));
+      MP_RETURN_IF_ERROR(graph.WaitUntilIdle());
+      latencies_us.push_back(absl::ToDoubleMicroseconds(absl::Now() - start));
+    }
+    const int64_t allocations = allocation_count.load() - allocations_before;
+    MP_RETURN_IF_ERROR(graph.CloseAllInputStreams());
+    MP_RETURN_IF_ERROR(graph.WaitUntilDone());
+    result->p50_us = Percentile(latencies_us, 0.5);
+    result->p99_us = Percentile(latencies_us, 0.99);
+    result->allocations_per_frame =
+        static_cast<double>(allocations) / num_frames;
+  }
+
+  // Throughput, all frames queued at once.
+  {
+    CalculatorGraph graph;
+    MP_RETURN_IF_ERROR(graph.Initialize(config));
+    MP_RETURN_IF_ERROR(graph.StartRun({}));
+    const absl::Time start = absl::Now();
+    for (int frame = 0; frame < num_frames; ++frame) {
+      MP_RETURN_IF_ERROR(AddFrame(inputs, frame, &graph));
+    }
+    MP_RETURN_IF_ERROR(graph.CloseAllInputStreams());
+    MP_RETURN_IF_ERROR(graph.WaitUntilDone());
+    result->frames_per_second =
+        num_frames / absl::ToDoubleSeconds(absl::Now() - start);
+  }
+  return ::mediapipe::OkStatus();
+}
+
+::mediapipe::Status RunBenchmarks() {
+  std::vector<LandmarkLogRecord> records;
+  if (FLAGS_landmark_log.empty()) {
+    records = GenerateSyntheticLandmarkLog(FLAGS_synthetic_frames,
+                                           FLAGS_synthetic_seed);
+    if (!FLAGS_write_synthetic_log.empty()) {
+      return WriteLandmarkLog(FLAGS_write_synthetic_log, records);
+    }
+  } else {
+    MP_RETURN_IF_ERROR(ReadLandmarkLog(FLAGS_landmark_log, &records));
+  }
+  RET_CHECK(!records.empty()) << "The landmark log has no frames.";
+
+  // All input packets are built before timing starts.
+  StreamInput landmarks{"landmarks", {}};
+  StreamInput rects{"rect", {}};
+  StreamInput hands{"hands", {}};
+  StreamInput texts{"text", {}};
+  HandLandmarksSoA hand;
+  for (const auto& record : records) {
+    const Timestamp timestamp(record.timestamp_us);
+    NormalizedLandmarkList landmark_list;
+    NormalizedRect rect;
+    FromLandmarkLogRecord(record, &landmark_list, &rect);
+
+    std::vector<std::vector<NormalizedLandmark>> frame_hands;
+    std::string text = "No Hand Detected";
+    if (HasHand(record)) {
+      frame_hands.emplace_back(landmark_list.landmark().begin(),
+                               landmark_list.landmark().end());
+      ToHandLandmarksSoA(landmark_list.landmark(), &hand);
+      // The rule engine stands in for the classifier, it gives the text
+      // stream a realistic rate of changes.
+      text = EvaluateGestureRules(hand).text;
+    }
+    landmarks.packets.push_back(
+        MakePacket<NormalizedLandmarkList>(std::move(landmark_list))
+            .At(timestamp));
+    rects.packets.push_back(
+        MakePacket<NormalizedRect>(std::move(rect)).At(timestamp));
+    hands.packets.push_back(
+        MakePacket<std::vector<std::vector<NormalizedLandmark>>>(
+            std::move(frame_hands))
+            .At(timestamp));
+    texts.packets.push_back(MakePacket<std::string>(text).At(timestamp));
+  }
+
+  const auto gesture_config = ParseTextProtoOrDie<CalculatorGraphConfig>(
+      absl::StrCat(R"(
+        input_stream: "landmarks"
+        input_stream: "rect"
+        node {
+          calculator: "HandGestureRecognitionCalculator"
+          input_stream: "NORM_LANDMARKS:landmarks"
+          input_stream: "NORM_RECT:rect"
+          output_stream: "ASL:letter"
+          output_stream: "CLASSIFICATION:classification"
+          node_options: {
+            [type.googleapis.com/mediapipe.HandGestureRecognitionCalculatorOptions] {
+              model_path: ")",
+                   FLAGS_model_path, R"("
+            }
+          }
+        })"));
+  const auto z_score_config = ParseTextProtoOrDie<CalculatorGraphConfig>(R"(
+    input_stream: "hands"
+    node {
+      calculator: "ZScoreCalculator"
+      input_stream: "LANDMARKS:hands"
+      output_stream: "FEATURES:features"
+    })");
+  const auto render_config = ParseTextProtoOrDie<CalculatorGraphConfig>(R"(
+    input_stream: "text"
+    node {
+      calculator: "StringToRenderDataCalculator"
+      input_stream: "TEXT:text"
+      output_stream: "RENDER_DATA:render_data"
+    })");
+
+  std::vector<BenchmarkResult> results(3);
+  MP_RETURN_IF_ERROR(RunBenchmark("HandGestureRecognitionCalculator",
+                                  gesture_config, {landmarks, rects},
+                                  &results[0]));
+  MP_RETURN_IF_ERROR(
+      RunBenchmark("ZScoreCalculator", z_score_config, {hands}, &results[1]));
+  MP_RETURN_IF_ERROR(RunBenchmark("StringToRenderDataCalculator",
+                                  render_config, {texts}, &results[2]));
+
+  std::printf("%-34s %8s %10s %10s %12s %12s\n", "calculator", "frames",
+              "p50 (us)", "p99 (us)", "allocs/frame", "frames/s");
+  for (const auto& result : results) {
+    std::printf("%-34s %8d %10.1f %10.1f %12.2f %12.0f\n",
+                result.calculator.c_str(), result.frames, result.p50_us,
+                result.p99_us, result.allocations_per_frame,
+                result.frames_per_second);
+  }
+  std::printf("feature kernels: %s\n", LandmarkFeatureKernelName());
+  return ::mediapipe::OkStatus();
+}
+
+}  // namespace
+
+}  // namespace mediapipe
+
+int main(int argc, char** argv) {
+  google::InitGoogleLogging(argv[0]);
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+  const ::mediapipe::Status status = ::mediapipe::RunBenchmarks();
+  if (!status.ok()) {
+    LOG(ERROR) << "Failed to run the benchmark: " << status.message();
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,104 @@
+#ifndef HAND_GESTURE_RECOGNITION_GESTURE_CLASSIFICATION_H_
+#define HAND_GESTURE_RECOGNITION_GESTURE_CLASSIFICATION_H_
+
+#include <algorithm>
+#include <cmath>
+
+namespace mediapipe {
+
+// Largest classifier output supported by GestureClassification.
+constexpr int kMaxGestureClasses = 32;
+constexpr int kGestureTopK = 3;
+
+// Result of classifying one hand. Plain fixed-size data, so packets carrying
+// it never allocate beyond the packet itself; turning the label into text is
+// left to the UI edge (GestureClassificationToStringCalculator).
+struct GestureClassification {
+  // `label` values that are not classifier outputs.
+  static constexpr int kUnknownLabel = -1;
+  static constexpr int kNoHand = -2;
+
+  // Position of the hand in the multi-hand input vector, 0 in single-hand
+  // mode.
+  int hand_id = 0;
+  // Index of the winning classifier output, or one of the constants above.
+  int label = kUnknownLabel;
+  // Calibrated probability of `label`, 0 when there is none.
+  float confidence = 0.f;
+
+  // Best kGestureTopK outputs, most likely first, with their calibrated
+  // probabilities. Unused slots have label kUnknownLabel.
+  int top_k_labels[kGestureTopK] = {kUnknownLabel, kUnknownLabel,
+                                    kUnknownLabel};
+  float top_k_scores[kGestureTopK] = {0.f, 0.f, 0.f};
+
+  // Raw classifier output, num_classes entries.
+  int num_classes = 0;
+  float probabilities[kMaxGestureClasses] = {};
+};
+
+// Fills `result` from `num_classes` classifier probabilities.
+//
+// `confidence` and the top-k scores are calibrated with `temperature`: the
+// probabilities are raised to 1 / temperature and renormalized, the softmax
+// of the logits divided by temperature. Above 1 softens overconfident models,
+// 1 keeps the raw probabilities. `probabilities` stays the raw output.
+// `label` is the argmax if its calibrated probability is above
+// `min_confidence` and kUnknownLabel otherwise.
+inline void FillGestureClassification(const float* scores, int num_classes,
+                                      float min_confidence,
+                                      GestureClassification* result,
+                                      float temperature = 1.f) {
+  num_classes = std::min(num_classes, kMaxGestureClasses);
+  result->num_classes = num_classes;
+  std::copy(scores, scores + num_classes, result->probabilities);
+
+  // Only the first kGestureTopK indices get sorted, higher score first and
+  // lower index first on ties.
+  int order[kMaxGestureClasses];
+  for (int i = 0; i < num_classes; ++i) order[i] = i;
+  const int top_k = std::min(kGestureTopK, num_classes);
+  std::partial_sort(order, order + top_k, order + num_classes,
+                    [scores](int a, int b) {
+                      return scores[a] > scores[b] ||
+                             (scores[a] == scores[b] && a < b);
+                    });
+
+  // Calibration keeps the order, so only the selected scores are needed,
+  // plus the normalization over all classes. Computed relative to the best
+  // score so that sharp temperatures cannot overflow.
+  const bool calibrate = temperature != 1.f && top_k > 0;
+  const float inverse_temperature = 1.f / temperature;
+  const float log_max =
+      calibrate ? std::log(std::max(scores[order[0]], 1e-30f)) : 0.f;
+  auto relative = [inverse_temperature, log_max](float score) {
+    return std::exp(inverse_temperature *
+                    (std::log(std::max(score, 1e-30f)) - log_max));
+  };
+  float norm = 0.f;
+  if (calibrate) {
+    for (int i = 0; i < num_classes; ++i) norm += relative(scores[i]);
+  }
+  for (int k = 0; k < kGestureTopK; ++k) {
+    if (k >= top_k) {
+      result->top_k_labels[k] = GestureClassification::kUnknownLabel;
+      result->top_k_scores[k] = 0.f;
+      continue;
+    }
+    const float score = scores[order[k]];
+    result->top_k_labels[k] = order[k];
+    result->top_k_scores[k] = calibrate ? relative(score) / norm : score;
+  }
+
+  if (top_k > 0 && result->top_k_scores[0] > min_confidence) {
+    result->label = result->top_k_labels[0];
+    result->confidence = result->top_k_scores[0];
+  } else {
+    result->label = GestureClassification::kUnknownLabel;
+    result->confidence = 0.f;
+  }
+}
+
+}  // namespace mediapipe
+
+#endif  // HAND_GESTURE_RECOGNITION_GESTURE_CLASSIFICATION_H_
@@ -0,0 +1,88 @@
+#include <string>
+#include <vector>
+
+#include "hand-gesture-recognition/gesture_classification.h"
+#include "hand-gesture-recognition/gesture_classification_to_string_calculator.pb.h"
+#include "hand-gesture-recognition/gesture_label_map.h"
+#include "mediapipe/framework/calculator_framework.h"
+#include "mediapipe/framework/port/ret_check.h"
+
+namespace mediapipe {
+
+namespace {
+
+constexpr char kClassificationTag[] = "CLASSIFICATION";
+constexpr char kTextTag[] = "TEXT";
+
+}  // namespace
+
+// Turns a GestureClassification into display text, for the UI edge of the
+// graph (e.g. StringToRenderDataCalculator or a Java packet callback).
+//
+// One text packet per label is built in Open() and shared by every output,
+// so no string is allocated per frame.
+//
+// Example config:
+// node {
+//   calculator: "GestureClassificationToStringCalculator"
+//   input_stream: "CLASSIFICATION:letter_classification"
+//   output_stream: "TEXT:letter_text"
+// }
+class GestureClassificationToStringCalculator : public CalculatorBase {
+ public:
+  static ::mediapipe::Status GetContract(CalculatorContract* cc);
+
+  ::mediapipe::Status Open(CalculatorContext* cc) override;
+
+  ::mediapipe::Status Process(CalculatorContext* cc) override;
+
+ private:
+  std::vector<Packet> label_packets_;
+  Packet unknown_label_packet_;
+  Packet no_hand_packet_;
+};
+REGISTER_CALCULATOR(GestureClassificationToStringCalculator);
+
+::mediapipe::Status GestureClassificationToStringCalculator::GetContract(
+    CalculatorContract* cc) {
+  RET_CHECK(cc->Inputs().HasTag(kClassificationTag));
+  RET_CHECK(cc->Outputs().HasTag(kTextTag));
+  cc->Inputs().Tag(kClassificationTag).Set<GestureClassification>();
+  cc->Outputs().Tag(kTextTag).Set<std::string>();
+  return ::mediapipe::OkStatus();
+}
+
+::mediapipe::Status GestureClassificationToStringCalculator::Open(
+    CalculatorContext* cc) {
+  cc->SetOffset(TimestampDiff(0));
+  const auto& options =
+      cc->Options<GestureClassificationToStringCalculatorOptions>();
+  std::vector<std::string> labels;
+  MP_RETURN_IF_ERROR(GetGestureLabels(options.label_map_path(),
+                                      options.labels(), 0, &labels));
+  for (const std::string& label : labels) {
+    label_packets_.push_back(MakePacket<std::string>(label));
+  }
+  unknown_label_packet_ = MakePacket<std::string>(options.unknown_label());
+  no_hand_packet_ = MakePacket<std::string>(options.no_hand_label());
+  return ::mediapipe::OkStatus();
+}
+
+::mediapipe::Status GestureClassificationToStringCalculator::Process(
+    CalculatorContext* cc) {
+  if (cc->Inputs().Tag(kClassificationTag).IsEmpty()) {
+    return ::mediapipe::OkStatus();
+  }
+  const int label =
+      cc->Inputs().Tag(kClassificationTag).Get<GestureClassification>().label;
+  const Packet* text = &unknown_label_packet_;
+  if (label == GestureClassification::kNoHand) {
+    text = &no_hand_packet_;
+  } else if (label >= 0 && label < label_packets_.size()) {
+    text = &label_packets_[label];
+  }
+  cc->Outputs().Tag(kTextTag).AddPacket(text->At(cc->InputTimestamp()));
+  return ::mediapipe::OkStatus();
+}
+
+}  // namespace mediapipe
@@ -0,0 +1,216 @@
+#include "hand-gesture-recognition/gesture_classifier.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+#include "absl/memory/memory.h"
+#include "mediapipe/framework/port/ret_check.h"
+#include "mediapipe/util/resource_util.h"
+#include "tensorflow/lite/delegates/xnnpack/xnnpack_delegate.h"
+#include "tensorflow/lite/kernels/register.h"
+#if defined(MEDIAPIPE_ANDROID)
+#include "tensorflow/lite/delegates/nnapi/nnapi_delegate.h"
+#endif  // MEDIAPIPE_ANDROID
+
+namespace mediapipe {
+
+namespace {
+
+bool IsQuantizedType(TfLiteType type) {
+  return type == kTfLiteInt8 || type == kTfLiteUInt8;
+}
+
+template <typename T>
+void Quantize(const float* values, int count,
+              const TfLiteQuantizationParams& params, T* out) {
+  const float inverse_scale = 1.f / params.scale;
+  for (int i = 0; i < count; ++i) {
+    const int32_t q =
+        static_cast<int32_t>(std::round(values[i] * inverse_scale)) +
+        params.zero_point;
+    out[i] = static_cast<T>(
+        std::min<int32_t>(std::max<int32_t>(q, std::numeric_limits<T>::min()),
+                          std::numeric_limits<T>::max()));
+  }
+}
+
+template <typename T>
+void Dequantize(const T* values, int count,
+                const TfLiteQuantizationParams& params, float* out) {
+  for (int i = 0; i < count; ++i) {
+    out[i] = params.scale *
+             (static_cast<int32_t>(values[i]) - params.zero_point);
+  }
+}
+
+#if defined(MEDIAPIPE_ANDROID)
+void DeleteNnApiDelegate(TfLiteDelegate* delegate) {
+  delete static_cast<tflite::StatefulNnApiDelegate*>(delegate);
+}
+#endif  // MEDIAPIPE_ANDROID
+
+}  // namespace
+
+::mediapipe::StatusOr<std::unique_ptr<GestureClassifier>>
+GestureClassifier::Create(const std::string& model_path,
+                          const Options& options) {
+  auto classifier = absl::WrapUnique(new GestureClassifier());
+  if (options.memory_map) {
+    std::string resolved_path;
+    ASSIGN_OR_RETURN(resolved_path, PathToResourceAsFile(model_path));
+    // BuildFromFile memory-maps the flatbuffer, it is never copied to the
+    // heap.
+    classifier->model_ =
+        tflite::FlatBufferModel::BuildFromFile(resolved_path.c_str());
+  } else {
+    MP_RETURN_IF_ERROR(
+        GetResourceContents(model_path, &classifier->model_data_));
+    classifier->model_ = tflite::FlatBufferModel::BuildFromBuffer(
+        classifier->model_data_.data(), classifier->model_data_.size());
+  }
+  RET_CHECK(classifier->model_) << "Failed to load model " << model_path;
+
+  classifier->op_resolver_ = options.op_resolver;
+  if (!classifier->op_resolver_) {
+    classifier->op_resolver_ =
+        std::make_shared<tflite::ops::builtin::BuiltinOpResolver>();
+  }
+  tflite::InterpreterBuilder(*classifier->model_, *classifier->op_resolver_)(
+      &classifier->interpreter_);
+  RET_CHECK(classifier->interpreter_) << "Failed to build the interpreter.";
+
+  tflite::Interpreter* interpreter = classifier->interpreter_.get();
+  interpreter->SetNumThreads(options.num_threads);
+  RET_CHECK_GT(options.feature_size, 0);
+  classifier->input_size_ = options.feature_size;
+  std::vector<int> input_shape = {options.feature_size};
+  if (!options.input_shape.empty()) {
+    input_shape = options.input_shape;
+    classifier->batchable_ = false;
+    classifier->input_size_ = 1;
+    for (int dim : input_shape) {
+      RET_CHECK_GT(dim, 0) << "Bad input shape.";
+      classifier->input_size_ *= dim;
+    }
+  }
+  RET_CHECK_EQ(
+      interpreter->ResizeInputTensor(interpreter->inputs()[0], input_shape),
+      kTfLiteOk);
+  MP_RETURN_IF_ERROR(classifier->ApplyDelegate(options));
+  RET_CHECK_EQ(interpreter->AllocateTensors(), kTfLiteOk);
+
+  const TfLiteTensor* input_tensor = interpreter->input_tensor(0);
+  const TfLiteTensor* output_tensor = interpreter->output_tensor(0);
+  RET_CHECK(input_tensor->type == kTfLiteFloat32 ||
+            IsQuantizedType(input_tensor->type))
+      << "Unsupported input type " << TfLiteTypeGetName(input_tensor->type);
+  RET_CHECK(output_tensor->type == kTfLiteFloat32 ||
+            IsQuantizedType(output_tensor->type))
+      << "Unsupported output type " << TfLiteTypeGetName(output_tensor->type);
+  classifier->quantized_input_ = IsQuantizedType(input_tensor->type);
+  classifier->quantized_output_ = IsQuantizedType(output_tensor->type);
+
+  RET_CHECK(output_tensor->dims->size > 0);
+  classifier->num_classes_ =
+      output_tensor->dims->data[output_tensor->dims->size - 1];
+  classifier->ResizeStaging();
+
+  return classifier;
+}
+
+::mediapipe::Status GestureClassifier::ApplyDelegate(const Options& options) {
+  delegate_type_ = options.delegate;
+  switch (options.delegate) {
+    case Delegate::kNone:
+      interpreter_->UseNNAPI(false);
+      return ::mediapipe::OkStatus();
+    case Delegate::kXnnpack: {
+      TfLiteXNNPackDelegateOptions xnnpack_options =
+          TfLiteXNNPackDelegateOptionsDefault();
+      xnnpack_options.num_threads = options.num_threads;
+      delegate_ = DelegatePtr(TfLiteXNNPackDelegateCreate(&xnnpack_options),
+                              &TfLiteXNNPackDelegateDelete);
+      break;
+    }
+    case Delegate::kNnapi: {
+#if defined(MEDIAPIPE_ANDROID)
+      delegate_ = DelegatePtr(new tflite::StatefulNnApiDelegate(),
+                              &DeleteNnApiDelegate);
+      break;
+#else
+      RET_CHECK_FAIL() << "The NNAPI delegate is only available on Android.";
+#endif  // MEDIAPIPE_ANDROID
+    }
+  }
+  RET_CHECK(delegate_) << "Failed to create the delegate.";
+  RET_CHECK_EQ(interpreter_->ModifyGraphWithDelegate(delegate_.get()),
+               kTfLiteOk);
+  return ::mediapipe::OkStatus();
+}
+
+void GestureClassifier::ResizeStaging() {
+  if (quantized_input_) {
+    input_staging_.resize(batch_size_ * input_size_);
+  }
+  if (quantized_output_) {
+    output_staging_.resize(batch_size_ * num_classes_);
+  }
+}
+
+::mediapipe::Status GestureClassifier::ResizeBatch(int batch_size) {
+  RET_CHECK_GT(batch_size, 0);
+  RET_CHECK(batchable_) << "Models with a custom input shape are not batched.";
+  if (batch_size == batch_size_) {
+    return ::mediapipe::OkStatus();
+  }
+  RET_CHECK_EQ(interpreter_->ResizeInputTensor(interpreter_->inputs()[0],
+                                               {batch_size, input_size_}),
+               kTfLiteOk);
+  RET_CHECK_EQ(interpreter_->AllocateTensors(), kTfLiteOk);
+  batch_size_ = batch_size;
+  ResizeStaging();
+  return ::mediapipe::OkStatus();
+}
+
+float* GestureClassifier::input() {
+  if (quantized_input_) {
+    return input_staging_.data();
+  }
+  return interpreter_->typed_input_tensor<float>(0);
+}
+
+::mediapipe::Status GestureClassifier::Invoke() {
+  if (quantized_input_) {
+    TfLiteTensor* tensor = interpreter_->input_tensor(0);
+    if (tensor->type == kTfLiteInt8) {
+      Quantize(input_staging_.data(), input_staging_.size(), tensor->params,
+               tensor->data.int8);
+    } else {
+      Quantize(input_staging_.data(), input_staging_.size(), tensor->params,
+               tensor->data.uint8);
+    }
+  }
+  RET_CHECK_EQ(interpreter_->Invoke(), kTfLiteOk);
+  if (quantized_output_) {
+    const TfLiteTensor* tensor = interpreter_->output_tensor(0);
+    if (tensor->type == kTfLiteInt8) {
+      Dequantize(tensor->data.int8, output_staging_.size(), tensor->params,
+                 output_staging_.data());
+    } else {
+      Dequantize(tensor->data.uint8, output_staging_.size(), tensor->params,
+                 output_staging_.data());
+    }
+  }
+  return ::mediapipe::OkStatus();
+}
+
+const float* GestureClassifier::output() const {
+  if (quantized_output_) {
+    return output_staging_.data();
+  }
+  return interpreter_->typed_output_tensor<float>(0);
+}
+
+}  // namespace mediapipe
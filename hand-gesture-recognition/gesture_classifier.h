@@ -0,0 +1,126 @@
+#ifndef HAND_GESTURE_RECOGNITION_GESTURE_CLASSIFIER_H_
+#define HAND_GESTURE_RECOGNITION_GESTURE_CLASSIFIER_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "mediapipe/framework/port/status.h"
+#include "mediapipe/framework/port/statusor.h"
+#include "tensorflow/lite/core/api/op_resolver.h"
+#include "tensorflow/lite/interpreter.h"
+#include "tensorflow/lite/model.h"
+
+namespace mediapipe {
+
+// Persistent TFLite session for the letter classifier.
+//
+// The model is memory-mapped and the interpreter and its tensors are
+// allocated once in Create(). Invoke() only runs the graph on whatever was
+// written into input(), so it can be called for every frame without touching
+// the heap.
+//
+// Float, float16 and int8 models are supported. float16 models take and
+// return float32 tensors. For int8 and uint8 models, input() and output()
+// stay float: the features are quantized into the input tensor and the
+// scores dequantized from the output tensor around Invoke(), with the
+// tensors' own scale and zero point.
+class GestureClassifier {
+ public:
+  // Default number of floats per hand: the z-scored x, y of the 21
+  // landmarks.
+  static constexpr int kFeatureSize = 42;
+
+  enum class Delegate {
+    // Built-in TFLite CPU kernels.
+    kNone,
+    // XNNPACK CPU delegate.
+    kXnnpack,
+    // Android Neural Networks API, Android only.
+    kNnapi,
+  };
+
+  struct Options {
+    Delegate delegate = Delegate::kNone;
+    int num_threads = 1;
+    // Floats per hand of a batched model, e.g. kInvariantFeatureSize for a
+    // model trained on the invariant features.
+    int feature_size = kFeatureSize;
+    // Shape of the input tensor. Empty for the letter classifier's
+    // [feature_size]; e.g. [1, frames, features] for a sequence model.
+    std::vector<int> input_shape;
+    // Memory-maps the model file. Otherwise the model is read into memory
+    // with GetResourceContents, for resources that are not plain files.
+    bool memory_map = true;
+    // Op resolver shared by several classifiers, e.g. by the models of a
+    // GestureModelRegistry. A BuiltinOpResolver of its own when null.
+    std::shared_ptr<const tflite::OpResolver> op_resolver;
+  };
+
+  // Loads the model found at `model_path` (resolved with PathToResourceAsFile,
+  // or read with GetResourceContents without memory_map), applies the
+  // delegate and allocates the interpreter tensors.
+  static ::mediapipe::StatusOr<std::unique_ptr<GestureClassifier>> Create(
+      const std::string& model_path, const Options& options);
+
+  GestureClassifier(const GestureClassifier&) = delete;
+  GestureClassifier& operator=(const GestureClassifier&) = delete;
+
+  // Resizes the input to [batch_size, feature_size] so several hands can be
+  // classified by one Invoke(). Tensors are only reallocated when the batch
+  // size actually changes. Not available with a custom input_shape.
+  ::mediapipe::Status ResizeBatch(int batch_size);
+  int batch_size() const { return batch_size_; }
+
+  // Input, batch_size() * input_size() floats. The input tensor itself for
+  // float models, a staging buffer for quantized ones.
+  float* input();
+  // Floats per sample: feature_size, or the product of input_shape.
+  int input_size() const { return input_size_; }
+
+  ::mediapipe::Status Invoke();
+
+  // Output, batch_size() * num_classes() floats. Valid until the next
+  // Invoke().
+  const float* output() const;
+  int num_classes() const { return num_classes_; }
+
+  // Whether the model takes integer inputs.
+  bool is_quantized() const { return quantized_input_; }
+  Delegate delegate() const { return delegate_type_; }
+
+ private:
+  using DelegatePtr =
+      std::unique_ptr<TfLiteDelegate, void (*)(TfLiteDelegate*)>;
+
+  GestureClassifier() = default;
+
+  ::mediapipe::Status ApplyDelegate(const Options& options);
+  // Sizes the staging buffers of quantized models for the current batch.
+  void ResizeStaging();
+
+  // Model contents when not memory-mapped, and the op resolver; both must
+  // outlive the model and the interpreter.
+  std::string model_data_;
+  std::shared_ptr<const tflite::OpResolver> op_resolver_;
+  std::unique_ptr<tflite::FlatBufferModel> model_;
+  // Must outlive the interpreter that uses it.
+  DelegatePtr delegate_{nullptr, [](TfLiteDelegate*) {}};
+  std::unique_ptr<tflite::Interpreter> interpreter_;
+  Delegate delegate_type_ = Delegate::kNone;
+  int input_size_ = kFeatureSize;
+  bool batchable_ = true;
+  int num_classes_ = 0;
+  int batch_size_ = 1;
+
+  // Float sides of the integer input and output tensors, only used when the
+  // tensor is quantized.
+  bool quantized_input_ = false;
+  bool quantized_output_ = false;
+  std::vector<float> input_staging_;
+  std::vector<float> output_staging_;
+};
+
+}  // namespace mediapipe
+
+#endif  // HAND_GESTURE_RECOGNITION_GESTURE_CLASSIFIER_H_
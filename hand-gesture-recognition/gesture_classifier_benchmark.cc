@@ -0,0 +1,201 @@
+// Compares the letter classifier across model variants and delegates on the
+// Linux CPU: float, float + XNNPACK and, when given, the float16 and int8
+// models with and without XNNPACK.
+//
+// Every configuration classifies the same hands, the z-scored frames of a
+// landmark log (a synthetic one without --landmark_log). The log has no
+// ground truth, so accuracy is reported against the first configuration,
+// the float model on the built-in kernels: top-1 agreement and the mean
+// absolute difference of the scores. Latency is that of Invoke() alone,
+// including the input quantization of int8 models.
+//
+// bazel run -c opt //hand-gesture-recognition:gesture_classifier_benchmark -- \
+//   --model_path=mediapipe/models/model_targeted_a.tflite \
+//   --int8_model_path=mediapipe/models/model_targeted_a_int8.tflite
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/time/clock.h"
+#include "hand-gesture-recognition/gesture_classifier.h"
+#include "hand-gesture-recognition/landmark_features.h"
+#include "hand-gesture-recognition/landmark_log.h"
+#include "mediapipe/framework/formats/landmark.pb.h"
+#include "mediapipe/framework/formats/rect.pb.h"
+#include "mediapipe/framework/port/commandlineflags.h"
+#include "mediapipe/framework/port/logging.h"
+#include "mediapipe/framework/port/ret_check.h"
+#include "mediapipe/framework/port/status.h"
+
+DEFINE_string(model_path, "mediapipe/models/model_targeted_a.tflite",
+              "Float letter classifier, the reference.");
+DEFINE_string(float16_model_path, "",
+              "Optional float16-quantized version of the classifier.");
+DEFINE_string(int8_model_path, "",
+              "Optional int8-quantized version of the classifier.");
+DEFINE_string(landmark_log, "",
+              "Landmark log to classify. A synthetic log is used when empty.");
+DEFINE_int32(synthetic_frames, 3000,
+             "Number of frames of the synthetic log.");
+DEFINE_int32(num_threads, 1, "Interpreter and XNNPACK threads.");
+DEFINE_int32(warmup_invokes, 20, "Untimed invokes before measuring.");
+
+namespace mediapipe {
+
+namespace {
+
+struct Variant {
+  std::string name;
+  std::string model_path;
+  GestureClassifier::Delegate delegate;
+};
+
+struct VariantResult {
+  double p50_us = 0;
+  double p99_us = 0;
+  double mean_us = 0;
+  // Argmax and scores of every hand.
+  std::vector<int> labels;
+  std::vector<float> scores;
+};
+
+double Percentile(std::vector<double> values, double fraction) {
+  const size_t index = std::min(values.size() - 1,
+                                static_cast<size_t>(fraction * values.size()));
+  std::nth_element(values.begin(), values.begin() + index, values.end());
+  return values[index];
+}
+
+::mediapipe::Status RunVariant(const Variant& variant,
+                               const std::vector<float>& features,
+                               VariantResult* result) {
+  GestureClassifier::Options options;
+  options.delegate = variant.delegate;
+  options.num_threads = FLAGS_num_threads;
+  std::unique_ptr<GestureClassifier> classifier;
+  ASSIGN_OR_RETURN(classifier,
+                   GestureClassifier::Create(variant.model_path, options));
+
+  const int num_hands = features.size() / GestureClassifier::kFeatureSize;
+  const int num_classes = classifier->num_classes();
+  for (int i = 0; i < FLAGS_warmup_invokes; ++i) {
+    std::copy_n(features.data(), GestureClassifier::kFeatureSize,
+                classifier->input());
+    MP_RETURN_IF_ERROR(classifier->Invoke());
+  }
+
+  std::vector<double> latencies_us;
+  latencies_us.reserve(num_hands);
+  result->labels.resize(num_hands);
+  result->scores.resize(num_hands * num_classes);
+  for (int hand = 0; hand < num_hands; ++hand) {
+    std::copy_n(features.data() + hand * GestureClassifier::kFeatureSize,
+                GestureClassifier::kFeatureSize, classifier->input());
+    const int64_t start_ns = absl::GetCurrentTimeNanos();
+    MP_RETURN_IF_ERROR(classifier->Invoke());
+    latencies_us.push_back((absl::GetCurrentTimeNanos() - start_ns) / 1000.);
+
+    const float* output = classifier->output();
+    std::copy_n(output, num_classes,
+                result->scores.data() + hand * num_classes);
+    result->labels[hand] =
+        std::max_element(output, output + num_classes) - output;
+  }
+  result->p50_us = Percentile(latencies_us, 0.5);
+  result->p99_us = Percentile(latencies_us, 0.99);
+  double total_us = 0;
+  for (double latency : latencies_us) total_us += latency;
+  result->mean_us = total_us / num_hands;
+  return ::mediapipe::OkStatus();
+}
+
+::mediapipe::Status RunBenchmark() {
+  std::vector<LandmarkLogRecord> records;
+  if (FLAGS_landmark_log.empty()) {
+    records = GenerateSyntheticLandmarkLog(FLAGS_synthetic_frames, 1);
+  } else {
+    MP_RETURN_IF_ERROR(ReadLandmarkLog(FLAGS_landmark_log, &records));
+  }
+
+  // Only frames with a hand reach the classifier.
+  std::vector<float> features;
+  HandLandmarksSoA hand;
+  NormalizedLandmarkList landmarks;
+  NormalizedRect rect;
+  for (const auto& record : records) {
+    if (!HasHand(record)) continue;
+    FromLandmarkLogRecord(record, &landmarks, &rect);
+    ToHandLandmarksSoA(landmarks.landmark(), &hand);
+    const size_t offset = features.size();
+    features.resize(offset + GestureClassifier::kFeatureSize);
+    ComputeZScoreFeatures(hand, features.data() + offset);
+  }
+  RET_CHECK(!features.empty()) << "The landmark log has no hands.";
+
+  std::vector<Variant> variants = {
+      {"float", FLAGS_model_path, GestureClassifier::Delegate::kNone},
+      {"float+xnnpack", FLAGS_model_path,
+       GestureClassifier::Delegate::kXnnpack},
+  };
+  if (!FLAGS_float16_model_path.empty()) {
+    variants.push_back({"float16", FLAGS_float16_model_path,
+                        GestureClassifier::Delegate::kNone});
+    variants.push_back({"float16+xnnpack", FLAGS_float16_model_path,
+                        GestureClassifier::Delegate::kXnnpack});
+  }
+  if (!FLAGS_int8_model_path.empty()) {
+    variants.push_back(
+        {"int8", FLAGS_int8_model_path, GestureClassifier::Delegate::kNone});
+    variants.push_back({"int8+xnnpack", FLAGS_int8_model_path,
+                        GestureClassifier::Delegate::kXnnpack});
+  }
+
+  std::vector<VariantResult> results(variants.size());
+  for (int v = 0; v < variants.size(); ++v) {
+    MP_RETURN_IF_ERROR(RunVariant(variants[v], features, &results[v]));
+    RET_CHECK_EQ(results[v].scores.size(), results[0].scores.size())
+        << variants[v].name << " has a different number of classes.";
+  }
+
+  const int num_hands = results[0].labels.size();
+  std::printf("%d hands, %d threads\n", num_hands, FLAGS_num_threads);
+  std::printf("%-16s %10s %10s %10s %12s %14s\n", "variant", "p50 (us)",
+              "p99 (us)", "mean (us)", "top-1 agree", "mean |dscore|");
+  for (int v = 0; v < variants.size(); ++v) {
+    int agreements = 0;
+    for (int i = 0; i < num_hands; ++i) {
+      agreements += results[v].labels[i] == results[0].labels[i];
+    }
+    double score_difference = 0;
+    for (int i = 0; i < results[v].scores.size(); ++i) {
+      score_difference +=
+          std::fabs(results[v].scores[i] - results[0].scores[i]);
+    }
+    std::printf("%-16s %10.1f %10.1f %10.1f %11.2f%% %14.5f\n",
+                variants[v].name.c_str(), results[v].p50_us,
+                results[v].p99_us, results[v].mean_us,
+                100. * agreements / num_hands,
+                score_difference / results[v].scores.size());
+  }
+  return ::mediapipe::OkStatus();
+}
+
+}  // namespace
+
+}  // namespace mediapipe
+
+int main(int argc, char** argv) {
+  google::InitGoogleLogging(argv[0]);
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+  const ::mediapipe::Status status = ::mediapipe::RunBenchmark();
+  if (!status.ok()) {
+    LOG(ERROR) << "Failed to run the benchmark: " << status.message();
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
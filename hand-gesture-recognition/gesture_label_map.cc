@@ -0,0 +1,66 @@
+#include "hand-gesture-recognition/gesture_label_map.h"
+
+#include <cctype>
+
+#include "mediapipe/framework/port/logging.h"
+#include "mediapipe/framework/port/ret_check.h"
+#include "mediapipe/util/resource_util.h"
+
+namespace mediapipe {
+
+::mediapipe::Status LoadGestureLabelMap(const std::string& path,
+                                        std::vector<std::string>* labels) {
+  std::string contents;
+  MP_RETURN_IF_ERROR(GetResourceContents(path, &contents));
+  labels->clear();
+  // A final newline ends the last label rather than starting an empty one.
+  size_t size = contents.size();
+  if (size > 0 && contents[size - 1] == '\n') --size;
+  RET_CHECK_GT(size, 0u) << path << " has no labels.";
+  size_t begin = 0;
+  while (true) {
+    size_t end = contents.find('\n', begin);
+    if (end == std::string::npos || end > size) end = size;
+    size_t last = end;
+    while (last > begin &&
+           std::isspace(static_cast<unsigned char>(contents[last - 1]))) {
+      --last;
+    }
+    // Skipping it would silently shift every later label.
+    RET_CHECK_GT(last, begin)
+        << path << " line " << labels->size() + 1 << " is blank.";
+    labels->emplace_back(contents, begin, last - begin);
+    if (end == size) break;
+    begin = end + 1;
+  }
+  return ::mediapipe::OkStatus();
+}
+
+::mediapipe::Status GetGestureLabels(const std::string& label_map_path,
+                                     const std::string& label_chars,
+                                     int num_classes,
+                                     std::vector<std::string>* labels) {
+  if (!label_map_path.empty()) {
+    MP_RETURN_IF_ERROR(LoadGestureLabelMap(label_map_path, labels));
+    RET_CHECK(num_classes == 0 ||
+              static_cast<int>(labels->size()) == num_classes)
+        << label_map_path << " has " << labels->size()
+        << " labels for a classifier with " << num_classes << " outputs.";
+    return ::mediapipe::OkStatus();
+  }
+  labels->clear();
+  for (char label : label_chars) {
+    labels->emplace_back(1, label);
+  }
+  RET_CHECK_GE(static_cast<int>(labels->size()), num_classes)
+      << "labels has fewer characters than the classifier has outputs.";
+  if (num_classes > 0 && static_cast<int>(labels->size()) != num_classes) {
+    LOG(WARNING) << "labels has " << labels->size()
+                 << " characters for a classifier with " << num_classes
+                 << " outputs; the last ones are never used. Check that the "
+                    "labels match the model, or use a label map.";
+  }
+  return ::mediapipe::OkStatus();
+}
+
+}  // namespace mediapipe
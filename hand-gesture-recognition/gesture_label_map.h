@@ -0,0 +1,35 @@
+#ifndef HAND_GESTURE_RECOGNITION_GESTURE_LABEL_MAP_H_
+#define HAND_GESTURE_RECOGNITION_GESTURE_LABEL_MAP_H_
+
+#include <string>
+#include <vector>
+
+#include "mediapipe/framework/port/status.h"
+
+namespace mediapipe {
+
+// Display text of every classifier output, in output order.
+//
+// Comes either from a label map file, one label per line, or from the
+// legacy `labels` option string, one character per output. The calculators
+// turning GestureClassification labels into text share it, so a model and
+// its labels are swapped together.
+
+// Reads the label map at `path`, resolved with GetResourceContents. Trailing
+// whitespace is stripped. Blank lines are rejected, since every later label
+// would land on the wrong output; only a final newline is allowed.
+::mediapipe::Status LoadGestureLabelMap(const std::string& path,
+                                        std::vector<std::string>* labels);
+
+// Loads `label_map_path` when set, otherwise splits `label_chars` into one
+// label per character. A label map must have exactly `num_classes` labels;
+// the character string must cover them, and extra characters are logged as
+// a likely model mismatch. `num_classes` 0 skips the checks.
+::mediapipe::Status GetGestureLabels(const std::string& label_map_path,
+                                     const std::string& label_chars,
+                                     int num_classes,
+                                     std::vector<std::string>* labels);
+
+}  // namespace mediapipe
+
+#endif  // HAND_GESTURE_RECOGNITION_GESTURE_LABEL_MAP_H_
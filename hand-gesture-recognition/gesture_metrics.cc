@@ -0,0 +1,75 @@
+#include "hand-gesture-recognition/gesture_metrics.h"
+
+#include <algorithm>
+
+#include "absl/strings/str_cat.h"
+
+namespace mediapipe {
+
+namespace {
+
+int BucketOf(int64_t duration_ns) {
+  int64_t us = duration_ns / 1000;
+  int bucket = 0;
+  while (us > 0 && bucket < LatencyHistogram::kNumBuckets - 1) {
+    us >>= 1;
+    ++bucket;
+  }
+  return bucket;
+}
+
+std::string HistogramString(const char* name,
+                            const LatencyHistogram& histogram) {
+  return absl::StrCat(name, ": n=", histogram.count(),
+                      " mean_us=", histogram.mean_us(),
+                      " p50_us<=", histogram.PercentileUs(0.5),
+                      " p99_us<=", histogram.PercentileUs(0.99),
+                      " max_us=", histogram.max_ns() / 1000);
+}
+
+}  // namespace
+
+void LatencyHistogram::Add(int64_t duration_ns) {
+  duration_ns = std::max<int64_t>(duration_ns, 0);
+  ++buckets_[BucketOf(duration_ns)];
+  ++count_;
+  sum_ns_ += duration_ns;
+  max_ns_ = std::max(max_ns_, duration_ns);
+}
+
+void LatencyHistogram::Reset() { *this = LatencyHistogram(); }
+
+double LatencyHistogram::mean_us() const {
+  return count_ == 0 ? 0. : sum_ns_ / (1000. * count_);
+}
+
+int64_t LatencyHistogram::PercentileUs(double fraction) const {
+  if (count_ == 0) return 0;
+  const int64_t rank =
+      std::max<int64_t>(1, static_cast<int64_t>(fraction * count_ + 0.5));
+  int64_t seen = 0;
+  for (int i = 0; i < kNumBuckets - 1; ++i) {
+    seen += buckets_[i];
+    if (seen >= rank) return int64_t{1} << i;
+  }
+  return max_ns_ / 1000;
+}
+
+std::string GestureMetrics::DebugString() const {
+  return absl::StrCat(
+      HistogramString("feature_extraction", feature_extraction), "\n",
+      HistogramString("invoke", invoke), "\n",
+      HistogramString("postprocessing", postprocessing), "\n",
+      "frames=", frames, " no_hand=", no_hand_frames,
+      " low_confidence=", low_confidence_frames,
+      " fallback=", fallback_frames, " fallback_rule_hits=",
+      fallback_rule_hits, " skipped=", skipped_frames,
+      " cascade_hits=", cascade_hits, " cascade_misses=", cascade_misses,
+      " cascade_hit_rate=",
+      cascade_hits + cascade_misses == 0
+          ? 0.
+          : static_cast<double>(cascade_hits) /
+                (cascade_hits + cascade_misses));
+}
+
+}  // namespace mediapipe
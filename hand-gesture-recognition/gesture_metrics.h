@@ -0,0 +1,98 @@
+#ifndef HAND_GESTURE_RECOGNITION_GESTURE_METRICS_H_
+#define HAND_GESTURE_RECOGNITION_GESTURE_METRICS_H_
+
+#include <cstdint>
+#include <string>
+
+#include "absl/time/clock.h"
+
+namespace mediapipe {
+
+// Metrics are compiled in unless HAND_GESTURE_METRICS_DISABLED is defined
+// (bazel build --define hand_gesture_metrics=disabled). When disabled, the
+// timers and counters below do nothing and compile away.
+#if defined(HAND_GESTURE_METRICS_DISABLED)
+constexpr bool kGestureMetricsEnabled = false;
+#else
+constexpr bool kGestureMetricsEnabled = true;
+#endif
+
+// Histogram of durations in power-of-two microsecond buckets: bucket 0 holds
+// durations under 1us, bucket i durations in [2^(i-1), 2^i) us and the last
+// bucket everything longer. Fixed size, adding a sample never allocates.
+class LatencyHistogram {
+ public:
+  static constexpr int kNumBuckets = 22;
+
+  void Add(int64_t duration_ns);
+  void Reset();
+
+  int64_t count() const { return count_; }
+  int64_t max_ns() const { return max_ns_; }
+  double mean_us() const;
+  // Upper bound of the bucket holding the `fraction` quantile, in us.
+  int64_t PercentileUs(double fraction) const;
+  int64_t bucket(int i) const { return buckets_[i]; }
+
+ private:
+  int64_t buckets_[kNumBuckets] = {};
+  int64_t count_ = 0;
+  int64_t sum_ns_ = 0;
+  int64_t max_ns_ = 0;
+};
+
+// Aggregated hot-path metrics of HandGestureRecognitionCalculator over a
+// dump interval. Copied as is into the METRICS output packets.
+struct GestureMetrics {
+  // Durations of the three stages of a classified frame.
+  LatencyHistogram feature_extraction;
+  LatencyHistogram invoke;
+  LatencyHistogram postprocessing;
+
+  int64_t frames = 0;
+  int64_t no_hand_frames = 0;
+  // Classified hands whose best label stayed under min_confidence.
+  int64_t low_confidence_frames = 0;
+  // Frames classified by the heuristic rules, and those a rule matched.
+  int64_t fallback_frames = 0;
+  int64_t fallback_rule_hits = 0;
+  // Frames that reused the previous result, see InferenceScheduler.
+  int64_t skipped_frames = 0;
+  // Cascade mode: hands settled by the rules without Invoke, and hands that
+  // went on to the model.
+  int64_t cascade_hits = 0;
+  int64_t cascade_misses = 0;
+
+  void Reset() { *this = GestureMetrics(); }
+  // One line per histogram and one for the counters.
+  std::string DebugString() const;
+};
+
+// Adds the time between construction and destruction to `histogram`.
+class ScopedStageTimer {
+ public:
+  explicit ScopedStageTimer(LatencyHistogram* histogram)
+      : histogram_(histogram) {
+    if (kGestureMetricsEnabled) start_ns_ = absl::GetCurrentTimeNanos();
+  }
+  ~ScopedStageTimer() {
+    if (kGestureMetricsEnabled) {
+      histogram_->Add(absl::GetCurrentTimeNanos() - start_ns_);
+    }
+  }
+  ScopedStageTimer(const ScopedStageTimer&) = delete;
+  ScopedStageTimer& operator=(const ScopedStageTimer&) = delete;
+
+ private:
+  LatencyHistogram* histogram_;
+  int64_t start_ns_ = 0;
+};
+
+// Counter increments that compile away with the metrics.
+inline void IncrementGestureMetric(int64_t* counter) {
+  if (kGestureMetricsEnabled) ++*counter;
+}
+
+}  // namespace mediapipe
+
+#endif  // HAND_GESTURE_RECOGNITION_GESTURE_METRICS_H_
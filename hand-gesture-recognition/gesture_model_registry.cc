@@ -0,0 +1,90 @@
+#include "hand-gesture-recognition/gesture_model_registry.h"
+
+#include <utility>
+
+#include "absl/strings/str_cat.h"
+#include "absl/time/clock.h"
+#include "tensorflow/lite/kernels/register.h"
+
+namespace mediapipe {
+
+GestureModel::GestureModel(std::string name, std::string path,
+                           std::unique_ptr<GestureClassifier> classifier)
+    : name_(std::move(name)),
+      path_(std::move(path)),
+      classifier_(std::move(classifier)) {}
+
+::mediapipe::Status GestureModel::Invoke() {
+  const int64_t start_ns = absl::GetCurrentTimeNanos();
+  MP_RETURN_IF_ERROR(classifier_->Invoke());
+  stats_.invoke.Add(absl::GetCurrentTimeNanos() - start_ns);
+  stats_.hands += classifier_->batch_size();
+  return ::mediapipe::OkStatus();
+}
+
+void GestureModel::RecordComparison(int hands, int agreements) {
+  stats_.compared_hands += hands;
+  stats_.agreements += agreements;
+}
+
+GestureModelStats GestureModel::stats() {
+  absl::MutexLock lock(&mutex_);
+  return stats_;
+}
+
+GestureModelRegistry::GestureModelRegistry(GestureClassifier::Options options)
+    : options_(std::move(options)),
+      models_(std::make_shared<const ModelMap>()) {
+  if (!options_.op_resolver) {
+    options_.op_resolver =
+        std::make_shared<tflite::ops::builtin::BuiltinOpResolver>();
+  }
+}
+
+::mediapipe::Status GestureModelRegistry::Load(const std::string& name,
+                                               const std::string& path) {
+  std::unique_ptr<GestureClassifier> classifier;
+  ASSIGN_OR_RETURN(classifier, GestureClassifier::Create(path, options_));
+  auto model =
+      std::make_shared<GestureModel>(name, path, std::move(classifier));
+
+  absl::MutexLock lock(&load_mutex_);
+  auto models = std::make_shared<ModelMap>(*models());
+  (*models)[name] = std::move(model);
+  std::atomic_store(&models_,
+                    std::shared_ptr<const ModelMap>(std::move(models)));
+  return ::mediapipe::OkStatus();
+}
+
+std::shared_ptr<GestureModel> GestureModelRegistry::Get(
+    const std::string& name) const {
+  const std::shared_ptr<const ModelMap> current = models();
+  const auto it = current->find(name);
+  return it == current->end() ? nullptr : it->second;
+}
+
+std::vector<std::string> GestureModelRegistry::names() const {
+  std::vector<std::string> names;
+  for (const auto& entry : *models()) {
+    names.push_back(entry.first);
+  }
+  return names;
+}
+
+std::string GestureModelRegistry::DebugString() const {
+  std::string result;
+  for (const auto& entry : *models()) {
+    const GestureModelStats stats = entry.second->stats();
+    absl::StrAppend(&result, entry.first, " (", entry.second->path(),
+                    "): invokes=", stats.invoke.count(),
+                    " hands=", stats.hands,
+                    " mean_us=", stats.invoke.mean_us(),
+                    " p50_us<=", stats.invoke.PercentileUs(0.5),
+                    " p99_us<=", stats.invoke.PercentileUs(0.99),
+                    " compared=", stats.compared_hands,
+                    " agreement=", stats.agreement_rate(), "\n");
+  }
+  return result;
+}
+
+}  // namespace mediapipe
@@ -0,0 +1,118 @@
+#ifndef HAND_GESTURE_RECOGNITION_GESTURE_MODEL_REGISTRY_H_
+#define HAND_GESTURE_RECOGNITION_GESTURE_MODEL_REGISTRY_H_
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/synchronization/mutex.h"
+#include "hand-gesture-recognition/gesture_classifier.h"
+#include "hand-gesture-recognition/gesture_metrics.h"
+#include "mediapipe/framework/port/status.h"
+
+namespace mediapipe {
+
+// What a GestureModel measured since it was loaded.
+struct GestureModelStats {
+  // Invoke latency, over every batch the model ran.
+  LatencyHistogram invoke;
+  int64_t hands = 0;
+  // Hands also classified by the active model while this one ran in its
+  // shadow, and how many of them both gave the same top-1 class.
+  int64_t compared_hands = 0;
+  int64_t agreements = 0;
+
+  double agreement_rate() const {
+    return compared_hands == 0 ? 0.
+                               : static_cast<double>(agreements) /
+                                     compared_hands;
+  }
+};
+
+// A loaded letter classifier of a GestureModelRegistry.
+//
+// Frames hold the model by shared_ptr, so a model replaced in the registry
+// stays alive until the frames using it are done. The interpreter is not
+// thread-safe: callers hold mutex() from writing the input to reading the
+// output.
+class GestureModel {
+ public:
+  GestureModel(std::string name, std::string path,
+               std::unique_ptr<GestureClassifier> classifier);
+
+  GestureModel(const GestureModel&) = delete;
+  GestureModel& operator=(const GestureModel&) = delete;
+
+  const std::string& name() const { return name_; }
+  const std::string& path() const { return path_; }
+
+  absl::Mutex* mutex() { return &mutex_; }
+  GestureClassifier* classifier() { return classifier_.get(); }
+
+  // Runs the classifier and records its latency. With mutex() held.
+  ::mediapipe::Status Invoke();
+  // Records `agreements` top-1 agreements with the active model over
+  // `hands` hands. With mutex() held.
+  void RecordComparison(int hands, int agreements);
+
+  GestureModelStats stats();
+
+ private:
+  const std::string name_;
+  const std::string path_;
+  absl::Mutex mutex_;
+  std::unique_ptr<GestureClassifier> classifier_;
+  GestureModelStats stats_;
+};
+
+// Letter classifiers by name, for switching and A/B testing models while a
+// graph runs.
+//
+// Every model is created with the same GestureClassifier::Options and one
+// shared op resolver. The name to model map is immutable and replaced as a
+// whole, copy on write, by Load(), and readers take the current map with
+// std::atomic_load. Lookups never wait on a Load() in progress, but they are
+// not lock-free: the standard library guards the shared_ptr with a short
+// internal lock while the reference count is taken. Load() builds the new
+// model before publishing it, so a swap never stalls the frames in flight;
+// they finish on the model they started with.
+//
+// Thread-safe. Typically shared between the graph and the application
+// through the MODEL_REGISTRY side packet of HandGestureRecognitionCalculator.
+class GestureModelRegistry {
+ public:
+  explicit GestureModelRegistry(GestureClassifier::Options options);
+
+  GestureModelRegistry(const GestureModelRegistry&) = delete;
+  GestureModelRegistry& operator=(const GestureModelRegistry&) = delete;
+
+  // Loads the model at `path` and publishes it under `name`, replacing the
+  // model that had the name, if any.
+  ::mediapipe::Status Load(const std::string& name, const std::string& path);
+
+  // The model published under `name`, null if there is none.
+  std::shared_ptr<GestureModel> Get(const std::string& name) const;
+
+  std::vector<std::string> names() const;
+
+  // One line of latency and agreement statistics per model.
+  std::string DebugString() const;
+
+ private:
+  using ModelMap = std::map<std::string, std::shared_ptr<GestureModel>>;
+
+  std::shared_ptr<const ModelMap> models() const {
+    return std::atomic_load(&models_);
+  }
+
+  GestureClassifier::Options options_;
+  // Serializes writers only.
+  absl::Mutex load_mutex_;
+  std::shared_ptr<const ModelMap> models_;
+};
+
+}  // namespace mediapipe
+
+#endif  // HAND_GESTURE_RECOGNITION_GESTURE_MODEL_REGISTRY_H_
@@ -0,0 +1,209 @@
+#include "hand-gesture-recognition/gesture_rules.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace mediapipe {
+
+namespace {
+
+constexpr uint8_t kAllFingers = kThumbOpen | kFirstFingerOpen |
+                                kSecondFingerOpen | kThirdFingerOpen |
+                                kFourthFingerOpen;
+constexpr int kNumFingerMasks = kAllFingers + 1;
+
+// Two landmarks are close when their x/y distance is below 0.085.
+constexpr float kCloseDistance = 0.085f;
+constexpr float kSquaredCloseDistance = kCloseDistance * kCloseDistance;
+
+struct LandmarkPair {
+  uint8_t a;
+  uint8_t b;
+};
+
+// Landmarks of each ClosePair bit, in bit order.
+constexpr LandmarkPair kClosePairs[] = {{6, 10}, {12, 8}, {4, 6}, {7, 6},
+                                        {7, 3},  {4, 9},  {4, 8}};
+constexpr int kNumClosePairs = sizeof(kClosePairs) / sizeof(kClosePairs[0]);
+
+struct GestureRule {
+  // Fingers the rule looks at, and their required states.
+  uint8_t finger_care;
+  uint8_t finger_value;
+  // Pairs that must be close, and pairs that must not be.
+  uint8_t close;
+  uint8_t far;
+  const char* text;
+};
+
+// The rules in priority order, the first match wins. X can never match, D
+// takes the same finger states first; it is kept so that the table reads
+// like the original rule chain.
+constexpr GestureRule kRules[] = {
+    {kAllFingers, kAllFingers, 0, 0, "C"},
+    {kAllFingers, kAllFingers & ~kThumbOpen, 0, 0, "B"},
+    {kAllFingers, kFirstFingerOpen, 0, 0, "D"},
+    {kAllFingers, kFirstFingerOpen | kSecondFingerOpen, kClose6To10,
+     kClose12To8, "U"},
+    {kAllFingers, kFirstFingerOpen | kSecondFingerOpen,
+     kClose6To10 | kClose12To8, 0, "R"},
+    {kAllFingers, kFirstFingerOpen | kSecondFingerOpen, kClose4To6, 0, "K"},
+    {kAllFingers, kFirstFingerOpen | kSecondFingerOpen, 0, 0, "V"},
+    {kAllFingers, kFirstFingerOpen | kSecondFingerOpen | kThirdFingerOpen, 0,
+     0, "W"},
+    {kAllFingers, kThumbOpen | kFirstFingerOpen | kFourthFingerOpen, 0, 0,
+     "I LOVE YOU!"},
+    {kAllFingers, kThumbOpen | kFourthFingerOpen, 0, 0, "Y"},
+    {kAllFingers, kFirstFingerOpen, kClose7To6, 0, "X"},
+    {kAllFingers, kThumbOpen | kFirstFingerOpen | kSecondFingerOpen,
+     kClose4To6, 0, "P"},
+    {kAllFingers, 0, kClose7To3, 0, "S"},
+    {kAllFingers, kThumbOpen, kClose4To9, 0, "T"},
+    {kAllFingers, kThumbOpen, kClose4To8, 0, "O"},
+    {kAllFingers, kThumbOpen, 0, 0, "A"},
+    {kAllFingers, kFourthFingerOpen, 0, 0, "I"},
+    {kAllFingers & ~kThumbOpen,
+     kSecondFingerOpen | kThirdFingerOpen | kFourthFingerOpen, kClose4To8, 0,
+     "F"},
+    {kAllFingers, kThumbOpen | kFirstFingerOpen, 0, 0, "L"},
+    {kAllFingers, 0, 0, kClose7To3, "E"},
+    {kAllFingers, kThumbOpen | kFirstFingerOpen | kSecondFingerOpen, 0, 0,
+     "H"},
+};
+constexpr int kNumRules = sizeof(kRules) / sizeof(kRules[0]);
+
+constexpr char kNoRuleText[] = "Not in ASL";
+
+constexpr bool RuleMatchesFingers(const GestureRule& rule, int finger_mask) {
+  return (finger_mask & rule.finger_care) == rule.finger_value;
+}
+
+constexpr int CountCandidates() {
+  int count = 0;
+  for (int mask = 0; mask < kNumFingerMasks; ++mask) {
+    for (int r = 0; r < kNumRules; ++r) {
+      if (RuleMatchesFingers(kRules[r], mask)) ++count;
+    }
+  }
+  return count;
+}
+constexpr int kNumCandidates = CountCandidates();
+
+// Rules that can match each finger mask, in priority order:
+// rules[begin[mask]] to rules[begin[mask + 1] - 1]. `pairs` has the close
+// pairs those rules look at, so only they are measured.
+struct RuleIndex {
+  uint8_t begin[kNumFingerMasks + 1];
+  uint8_t rules[kNumCandidates];
+  uint8_t pairs[kNumFingerMasks];
+};
+
+constexpr RuleIndex BuildRuleIndex() {
+  RuleIndex index{};
+  int count = 0;
+  for (int mask = 0; mask < kNumFingerMasks; ++mask) {
+    index.begin[mask] = count;
+    for (int r = 0; r < kNumRules; ++r) {
+      if (!RuleMatchesFingers(kRules[r], mask)) continue;
+      index.rules[count++] = r;
+      index.pairs[mask] |= kRules[r].close | kRules[r].far;
+    }
+  }
+  index.begin[kNumFingerMasks] = count;
+  return index;
+}
+constexpr RuleIndex kRuleIndex = BuildRuleIndex();
+
+static_assert(kNumRules < 256, "Rule indices are stored as uint8_t.");
+static_assert(kNumClosePairs <= 8, "Close pairs are stored as uint8_t bits.");
+
+// Measures the pairs in `pairs` only, each once. With `margin`, also lowers
+// it to the distance of the nearest measured pair to the threshold.
+uint8_t ComputeCloseMask(const HandLandmarksSoA& hand, uint8_t pairs,
+                         float* margin = nullptr) {
+  uint8_t close_mask = 0;
+  for (int i = 0; i < kNumClosePairs; ++i) {
+    if (!(pairs & (1 << i))) continue;
+    const float dx = hand.x[kClosePairs[i].a] - hand.x[kClosePairs[i].b];
+    const float dy = hand.y[kClosePairs[i].a] - hand.y[kClosePairs[i].b];
+    const float squared_distance = dx * dx + dy * dy;
+    if (squared_distance < kSquaredCloseDistance) close_mask |= 1 << i;
+    if (margin != nullptr) {
+      *margin = std::min(
+          *margin, std::fabs(std::sqrt(squared_distance) - kCloseDistance));
+    }
+  }
+  return close_mask;
+}
+
+// A finger is open when both joints above `base` are above it in the image.
+inline bool IsFingerOpen(const HandLandmarksSoA& hand, int base) {
+  return hand.y[base + 1] < hand.y[base] && hand.y[base + 2] < hand.y[base];
+}
+
+// Distance of the comparisons of ComputeFingerMask to a tie.
+float FingerMaskMargin(const HandLandmarksSoA& hand) {
+  float margin = std::min(std::fabs(hand.x[3] - hand.x[2]),
+                          std::fabs(hand.x[4] - hand.x[2]));
+  for (int base = 6; base <= 18; base += 4) {
+    margin = std::min(margin, std::fabs(hand.y[base + 1] - hand.y[base]));
+    margin = std::min(margin, std::fabs(hand.y[base + 2] - hand.y[base]));
+  }
+  return margin;
+}
+
+}  // namespace
+
+uint8_t ComputeFingerMask(const HandLandmarksSoA& hand) {
+  uint8_t mask = 0;
+  if (hand.x[3] < hand.x[2] && hand.x[4] < hand.x[2]) mask |= kThumbOpen;
+  if (IsFingerOpen(hand, 6)) mask |= kFirstFingerOpen;
+  if (IsFingerOpen(hand, 10)) mask |= kSecondFingerOpen;
+  if (IsFingerOpen(hand, 14)) mask |= kThirdFingerOpen;
+  if (IsFingerOpen(hand, 18)) mask |= kFourthFingerOpen;
+  return mask;
+}
+
+uint8_t ComputeCloseMask(const HandLandmarksSoA& hand) {
+  return ComputeCloseMask(hand, (1 << kNumClosePairs) - 1);
+}
+
+GestureRuleResult EvaluateGestureRules(const HandLandmarksSoA& hand) {
+  return EvaluateGestureRules(hand, hand);
+}
+
+GestureRuleResult EvaluateGestureRules(const HandLandmarksSoA& hand,
+                                       const HandLandmarksSoA& canonical) {
+  const uint8_t finger_mask = ComputeFingerMask(canonical);
+  float margin = FingerMaskMargin(canonical);
+  const uint8_t close_mask =
+      ComputeCloseMask(hand, kRuleIndex.pairs[finger_mask], &margin);
+  GestureRuleResult result = EvaluateGestureRules(finger_mask, close_mask);
+  result.margin = margin;
+  return result;
+}
+
+GestureRuleResult EvaluateGestureRules(uint8_t finger_mask,
+                                       uint8_t close_mask) {
+  finger_mask &= kAllFingers;
+  GestureRuleResult result;
+  result.finger_mask = finger_mask;
+  result.close_mask = close_mask;
+  result.text = kNoRuleText;
+  for (int i = kRuleIndex.begin[finger_mask];
+       i < kRuleIndex.begin[finger_mask + 1]; ++i) {
+    const GestureRule& rule = kRules[kRuleIndex.rules[i]];
+    if ((close_mask & rule.close) == rule.close && !(close_mask & rule.far)) {
+      result.rule = kRuleIndex.rules[i];
+      result.text = rule.text;
+      break;
+    }
+  }
+  return result;
+}
+
+int NumGestureRules() { return kNumRules; }
+
+const char* GestureRuleText(int rule) { return kRules[rule].text; }
+
+}  // namespace mediapipe
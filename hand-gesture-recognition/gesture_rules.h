@@ -0,0 +1,82 @@
+#ifndef HAND_GESTURE_RECOGNITION_GESTURE_RULES_H_
+#define HAND_GESTURE_RECOGNITION_GESTURE_RULES_H_
+
+#include <cstdint>
+
+#include "hand-gesture-recognition/landmark_features.h"
+
+namespace mediapipe {
+
+// Heuristic ASL classifier working on finger states, used when the TFLite
+// model is not.
+//
+// The five finger states are packed into a 5-bit mask that indexes a
+// constexpr table of candidate rules, and the few landmark pairs the rules
+// look at are each compared once, as squared distances. Evaluating a hand is
+// a handful of compares, cheap enough to run before model inference.
+
+// Bits of the finger mask, set when the finger is open.
+enum FingerBit : uint8_t {
+  kThumbOpen = 1 << 0,
+  kFirstFingerOpen = 1 << 1,
+  kSecondFingerOpen = 1 << 2,
+  kThirdFingerOpen = 1 << 3,
+  kFourthFingerOpen = 1 << 4,
+};
+
+// Landmark pairs the rules test for closeness, as bits of a close mask.
+enum ClosePair : uint8_t {
+  kClose6To10 = 1 << 0,
+  kClose12To8 = 1 << 1,
+  kClose4To6 = 1 << 2,
+  kClose7To6 = 1 << 3,
+  kClose7To3 = 1 << 4,
+  kClose4To9 = 1 << 5,
+  kClose4To8 = 1 << 6,
+};
+
+struct GestureRuleResult {
+  uint8_t finger_mask = 0;
+  uint8_t close_mask = 0;
+  // Index of the matching rule, -1 when no rule matched.
+  int rule = -1;
+  // Display text of the rule, e.g. "B" or "I LOVE YOU!". "Not in ASL" when
+  // no rule matched.
+  const char* text = nullptr;
+  // Smallest distance, in image units, between one of the landmark
+  // comparisons behind the masks and its decision threshold. A small margin
+  // means a little jitter could flip the result. 0 when evaluated from
+  // masks.
+  float margin = 0.f;
+};
+
+// Finger mask of an upright hand with the index finger left of the pinky,
+// e.g. a hand mapped by CanonicalizeHand. In raw image coordinates the thumb
+// test is wrong for the other hand and every test for tilted hands.
+uint8_t ComputeFingerMask(const HandLandmarksSoA& hand);
+
+// Close mask of a hand: bit set when the pair is nearer than the rule
+// threshold.
+uint8_t ComputeCloseMask(const HandLandmarksSoA& hand);
+
+GestureRuleResult EvaluateGestureRules(const HandLandmarksSoA& hand);
+
+// Same, with the finger mask taken from `canonical`, the hand mapped by
+// CanonicalizeHand, so that the rules hold for left and rotated hands. The
+// close pairs are still measured on `hand`, against the image-unit
+// threshold.
+GestureRuleResult EvaluateGestureRules(const HandLandmarksSoA& hand,
+                                       const HandLandmarksSoA& canonical);
+
+// Same, for already computed masks.
+GestureRuleResult EvaluateGestureRules(uint8_t finger_mask,
+                                       uint8_t close_mask);
+
+// Number of rules, and the display text of rule `rule`, for mapping rule
+// indices to classifier labels once.
+int NumGestureRules();
+const char* GestureRuleText(int rule);
+
+}  // namespace mediapipe
+
+#endif  // HAND_GESTURE_RECOGNITION_GESTURE_RULES_H_
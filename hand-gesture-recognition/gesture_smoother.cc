@@ -0,0 +1,117 @@
+#include "hand-gesture-recognition/gesture_smoother.h"
+
+#include <algorithm>
+
+namespace mediapipe {
+
+namespace {
+
+int ArgMax(const float* values, int size) {
+  return std::max_element(values, values + size) - values;
+}
+
+}  // namespace
+
+GestureSmoother::GestureSmoother(const Params& params, int num_classes)
+    : params_(params), num_classes_(num_classes) {
+  params_.window_size = std::max(params_.window_size, 1);
+  if (params_.method == Method::kMovingAverage) {
+    window_.resize(params_.window_size * num_classes_);
+  } else if (params_.method == Method::kMajority) {
+    window_labels_.resize(params_.window_size);
+  }
+  sums_.resize(num_classes_);
+  scores_.resize(num_classes_);
+  Reset();
+}
+
+void GestureSmoother::Reset() {
+  std::fill(sums_.begin(), sums_.end(), 0.f);
+  std::fill(scores_.begin(), scores_.end(), 0.f);
+  head_ = 0;
+  filled_ = 0;
+  stable_label_ = kUnknownLabel;
+  candidate_label_ = kUnknownLabel;
+  candidate_frames_ = 0;
+}
+
+float GestureSmoother::stable_score() const {
+  return stable_label_ == kUnknownLabel ? 0.f : scores_[stable_label_];
+}
+
+void GestureSmoother::UpdateScores(const float* probabilities) {
+  const bool full = filled_ == params_.window_size;
+  switch (params_.method) {
+    case Method::kMovingAverage: {
+      float* slot = &window_[head_ * num_classes_];
+      for (int i = 0; i < num_classes_; ++i) {
+        if (full) sums_[i] -= slot[i];
+        slot[i] = probabilities[i];
+        sums_[i] += probabilities[i];
+      }
+      break;
+    }
+    case Method::kExponential: {
+      for (int i = 0; i < num_classes_; ++i) {
+        sums_[i] = filled_ == 0 ? probabilities[i]
+                                : params_.alpha * probabilities[i] +
+                                      (1.f - params_.alpha) * sums_[i];
+      }
+      break;
+    }
+    case Method::kMajority: {
+      if (full) sums_[window_labels_[head_]] -= 1.f;
+      window_labels_[head_] = ArgMax(probabilities, num_classes_);
+      sums_[window_labels_[head_]] += 1.f;
+      break;
+    }
+  }
+
+  head_ = (head_ + 1) % params_.window_size;
+  if (!full) ++filled_;
+
+  if (params_.method == Method::kMovingAverage && head_ == 0) {
+    // Re-sum once per window so the running sums cannot drift.
+    std::fill(sums_.begin(), sums_.end(), 0.f);
+    for (int k = 0; k < filled_; ++k) {
+      for (int i = 0; i < num_classes_; ++i) {
+        sums_[i] += window_[k * num_classes_ + i];
+      }
+    }
+  }
+
+  const float norm =
+      params_.method == Method::kExponential ? 1.f : 1.f / filled_;
+  for (int i = 0; i < num_classes_; ++i) scores_[i] = sums_[i] * norm;
+}
+
+bool GestureSmoother::Update(const float* probabilities) {
+  UpdateScores(probabilities);
+
+  const int best = ArgMax(scores_.data(), num_classes_);
+  int target = stable_label_;
+  if (scores_[best] < params_.unknown_threshold) {
+    target = kUnknownLabel;
+  } else if (best != stable_label_ &&
+             scores_[best] >= params_.enter_threshold &&
+             scores_[best] - stable_score() >= params_.hysteresis_margin) {
+    target = best;
+  }
+
+  if (target == stable_label_) {
+    candidate_frames_ = 0;
+    return false;
+  }
+  if (target != candidate_label_) {
+    candidate_label_ = target;
+    candidate_frames_ = 0;
+  }
+  if (++candidate_frames_ < params_.min_stable_frames) {
+    return false;
+  }
+  stable_label_ = target;
+  candidate_frames_ = 0;
+  return true;
+}
+
+}  // namespace mediapipe
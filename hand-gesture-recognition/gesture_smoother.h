@@ -0,0 +1,69 @@
+#ifndef HAND_GESTURE_RECOGNITION_GESTURE_SMOOTHER_H_
+#define HAND_GESTURE_RECOGNITION_GESTURE_SMOOTHER_H_
+
+#include <vector>
+
+namespace mediapipe {
+
+// Turns a stream of per-frame class probabilities into a stable label.
+//
+// The last `window_size` probability vectors are kept in a ring buffer
+// allocated up front, smoothed with the configured method, and the stable
+// label only changes after a candidate wins with hysteresis for
+// `min_stable_frames` consecutive frames. Update() never allocates.
+class GestureSmoother {
+ public:
+  static constexpr int kUnknownLabel = -1;
+
+  enum class Method { kMovingAverage, kExponential, kMajority };
+
+  struct Params {
+    Method method = Method::kMovingAverage;
+    int window_size = 5;
+    float alpha = 0.5f;
+    float enter_threshold = 0.5f;
+    float hysteresis_margin = 0.1f;
+    int min_stable_frames = 3;
+    float unknown_threshold = 0.3f;
+  };
+
+  GestureSmoother(const Params& params, int num_classes);
+
+  // Adds the probabilities of one frame (num_classes() floats) and returns
+  // true when the stable label changed.
+  bool Update(const float* probabilities);
+
+  // Forgets all history, e.g. when the hand leaves the frame.
+  void Reset();
+
+  int num_classes() const { return num_classes_; }
+  // Index of the stable label, or kUnknownLabel.
+  int stable_label() const { return stable_label_; }
+  // Smoothed score of the stable label, 0 when unknown.
+  float stable_score() const;
+  // Smoothed score of every class after the last Update().
+  const std::vector<float>& scores() const { return scores_; }
+
+ private:
+  void UpdateScores(const float* probabilities);
+
+  Params params_;
+  int num_classes_;
+
+  // window_size * num_classes probabilities for kMovingAverage, window_size
+  // argmax labels for kMajority.
+  std::vector<float> window_;
+  std::vector<int> window_labels_;
+  std::vector<float> sums_;
+  std::vector<float> scores_;
+  int head_ = 0;
+  int filled_ = 0;
+
+  int stable_label_ = kUnknownLabel;
+  int candidate_label_ = kUnknownLabel;
+  int candidate_frames_ = 0;
+};
+
+}  // namespace mediapipe
+
+#endif  // HAND_GESTURE_RECOGNITION_GESTURE_SMOOTHER_H_
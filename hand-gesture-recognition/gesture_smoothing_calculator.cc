@@ -0,0 +1,183 @@
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/memory/memory.h"
+#include "hand-gesture-recognition/gesture_classification.h"
+#include "hand-gesture-recognition/gesture_label_map.h"
+#include "hand-gesture-recognition/gesture_smoother.h"
+#include "hand-gesture-recognition/gesture_smoothing_calculator.pb.h"
+#include "mediapipe/framework/calculator_framework.h"
+#include "mediapipe/framework/port/ret_check.h"
+
+namespace mediapipe {
+
+namespace {
+
+constexpr char kProbabilitiesTag[] = "PROBABILITIES";
+constexpr char kClassificationTag[] = "CLASSIFICATION";
+constexpr char kLabelTag[] = "LABEL";
+
+GestureSmoother::Params ToSmootherParams(
+    const GestureSmoothingCalculatorOptions& options) {
+  GestureSmoother::Params params;
+  switch (options.method()) {
+    case GestureSmoothingCalculatorOptions::MOVING_AVERAGE:
+      params.method = GestureSmoother::Method::kMovingAverage;
+      break;
+    case GestureSmoothingCalculatorOptions::EXPONENTIAL:
+      params.method = GestureSmoother::Method::kExponential;
+      break;
+    case GestureSmoothingCalculatorOptions::MAJORITY:
+      params.method = GestureSmoother::Method::kMajority;
+      break;
+  }
+  params.window_size = options.window_size();
+  params.alpha = options.alpha();
+  params.enter_threshold = options.enter_threshold();
+  params.hysteresis_margin = options.hysteresis_margin();
+  params.min_stable_frames = options.min_stable_frames();
+  params.unknown_threshold = options.unknown_threshold();
+  return params;
+}
+
+}  // namespace
+
+// Smooths the per-frame letter probabilities of HandGestureRecognitionCalculator
+// and only outputs a label when the stable label changes.
+//
+// The probabilities come either from a GestureClassification on
+// CLASSIFICATION or from a plain float vector on PROBABILITIES. A kNoHand
+// classification or an empty vector clears the history and outputs
+// `no_hand_label` once.
+//
+// Labels come from label_map_path, or from the `labels` characters, like in
+// HandGestureRecognitionCalculator; use the same settings for both.
+//
+// Frames that do not change the stable label produce no packet, only a
+// timestamp bound update, so the render and Java callbacks downstream run
+// once per letter instead of once per frame.
+//
+// Example config:
+// node {
+//   calculator: "GestureSmoothingCalculator"
+//   input_stream: "CLASSIFICATION:letter_classification"
+//   output_stream: "LABEL:stable_letter"
+//   node_options: {
+//     [type.googleapis.com/mediapipe.GestureSmoothingCalculatorOptions] {
+//       method: MAJORITY
+//       window_size: 7
+//     }
+//   }
+// }
+class GestureSmoothingCalculator : public CalculatorBase {
+ public:
+  static ::mediapipe::Status GetContract(CalculatorContract* cc);
+
+  ::mediapipe::Status Open(CalculatorContext* cc) override;
+
+  ::mediapipe::Status Process(CalculatorContext* cc) override;
+
+ private:
+  GestureSmoothingCalculatorOptions options_;
+  // Created on the first packet, once the number of classes is known.
+  std::unique_ptr<GestureSmoother> smoother_;
+  // Whether the last LABEL packet was the no-hand label.
+  bool no_hand_ = false;
+  // One text packet per classifier output, shared by every output.
+  std::vector<Packet> label_packets_;
+  Packet unknown_label_packet_;
+  Packet no_hand_packet_;
+};
+REGISTER_CALCULATOR(GestureSmoothingCalculator);
+
+::mediapipe::Status GestureSmoothingCalculator::GetContract(
+    CalculatorContract* cc) {
+  RET_CHECK(cc->Inputs().HasTag(kProbabilitiesTag) ^
+            cc->Inputs().HasTag(kClassificationTag))
+      << "Exactly one of PROBABILITIES or CLASSIFICATION must be provided.";
+  RET_CHECK(cc->Outputs().HasTag(kLabelTag));
+  if (cc->Inputs().HasTag(kProbabilitiesTag)) {
+    cc->Inputs().Tag(kProbabilitiesTag).Set<std::vector<float>>();
+  } else {
+    cc->Inputs().Tag(kClassificationTag).Set<GestureClassification>();
+  }
+  cc->Outputs().Tag(kLabelTag).Set<std::string>();
+  return ::mediapipe::OkStatus();
+}
+
+::mediapipe::Status GestureSmoothingCalculator::Open(CalculatorContext* cc) {
+  cc->SetOffset(TimestampDiff(0));
+  options_ = cc->Options<GestureSmoothingCalculatorOptions>();
+  RET_CHECK_GT(options_.window_size(), 0);
+  RET_CHECK_GT(options_.min_stable_frames(), 0);
+  std::vector<std::string> labels;
+  MP_RETURN_IF_ERROR(GetGestureLabels(options_.label_map_path(),
+                                      options_.labels(), 0, &labels));
+  for (const std::string& label : labels) {
+    label_packets_.push_back(MakePacket<std::string>(label));
+  }
+  unknown_label_packet_ = MakePacket<std::string>(options_.unknown_label());
+  no_hand_packet_ = MakePacket<std::string>(options_.no_hand_label());
+  return ::mediapipe::OkStatus();
+}
+
+::mediapipe::Status GestureSmoothingCalculator::Process(CalculatorContext* cc) {
+  const float* probabilities = nullptr;
+  int num_classes = 0;
+  if (cc->Inputs().HasTag(kProbabilitiesTag)) {
+    if (cc->Inputs().Tag(kProbabilitiesTag).IsEmpty()) {
+      return ::mediapipe::OkStatus();
+    }
+    const auto& input =
+        cc->Inputs().Tag(kProbabilitiesTag).Get<std::vector<float>>();
+    probabilities = input.data();
+    num_classes = input.size();
+  } else {
+    if (cc->Inputs().Tag(kClassificationTag).IsEmpty()) {
+      return ::mediapipe::OkStatus();
+    }
+    const auto& classification =
+        cc->Inputs().Tag(kClassificationTag).Get<GestureClassification>();
+    probabilities = classification.probabilities;
+    num_classes = classification.num_classes;
+  }
+
+  if (num_classes == 0) {
+    // No hand: the next hand starts from an empty history.
+    if (smoother_) smoother_->Reset();
+    if (!no_hand_) {
+      no_hand_ = true;
+      cc->Outputs().Tag(kLabelTag).AddPacket(
+          no_hand_packet_.At(cc->InputTimestamp()));
+    }
+    return ::mediapipe::OkStatus();
+  }
+
+  if (!smoother_) {
+    RET_CHECK(options_.label_map_path().empty() ||
+              num_classes == static_cast<int>(label_packets_.size()))
+        << options_.label_map_path() << " has " << label_packets_.size()
+        << " labels for a classifier with " << num_classes << " outputs.";
+    smoother_ = absl::make_unique<GestureSmoother>(ToSmootherParams(options_),
+                                                   num_classes);
+  }
+  RET_CHECK_EQ(num_classes, smoother_->num_classes());
+
+  // The first frame of a new hand replaces the no-hand text even when the
+  // stable label stays unknown.
+  if (!smoother_->Update(probabilities) && !no_hand_) {
+    return ::mediapipe::OkStatus();
+  }
+  no_hand_ = false;
+
+  const int label = smoother_->stable_label();
+  const Packet& text =
+      label >= 0 && label < static_cast<int>(label_packets_.size())
+          ? label_packets_[label]
+          : unknown_label_packet_;
+  cc->Outputs().Tag(kLabelTag).AddPacket(text.At(cc->InputTimestamp()));
+  return ::mediapipe::OkStatus();
+}
+
+}  // namespace mediapipe
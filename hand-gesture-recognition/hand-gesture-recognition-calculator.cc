@@ -7,19 +7,30 @@
 #include <algorithm>
 #include <memory>
 #include <array>
+#include <limits>
 //#include <dos.h>
+#include "absl/memory/memory.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
+#include "absl/types/optional.h"
 #include "mediapipe/framework/calculator_framework.h"
 #include "mediapipe/framework/formats/landmark.pb.h"
 #include "mediapipe/framework/formats/rect.pb.h"
 #include "mediapipe/framework/input_stream_handler.h"
-#include "tensorflow/lite/kernels/register.h"
-#include "mediapipe/util/resource_util.h"
-#if defined(MEDIAPIPE_ANDROID)
-#include "tensorflow/lite/delegates/nnapi/nnapi_delegate.h"
-#endif  // ANDROID
-
-void stringToFile();
-std::string ASL_Word;
+#include "hand-gesture-recognition/async_gesture_classifier.h"
+#include "hand-gesture-recognition/gesture_classification.h"
+#include "hand-gesture-recognition/gesture_classifier.h"
+#include "hand-gesture-recognition/gesture_label_map.h"
+#include "hand-gesture-recognition/gesture_metrics.h"
+#include "hand-gesture-recognition/gesture_model_registry.h"
+#include "hand-gesture-recognition/gesture_rules.h"
+#include "hand-gesture-recognition/hand_gesture_recognition_calculator.pb.h"
+#include "hand-gesture-recognition/hand_track_table.h"
+#include "hand-gesture-recognition/inference_scheduler.h"
+#include "hand-gesture-recognition/landmark_features.h"
+#include "hand-gesture-recognition/landmark_sequence_window.h"
+
 namespace mediapipe
 {
 
@@ -27,7 +38,116 @@ namespace
 {
 constexpr char normRectTag[] = "NORM_RECT";
 constexpr char normalizedLandmarkListTag[] = "NORM_LANDMARKS";
+constexpr char multiNormRectTag[] = "MULTI_NORM_RECTS";
+constexpr char multiNormalizedLandmarkListTag[] = "MULTI_NORM_LANDMARKS";
+constexpr char multiASLTag[] = "MULTI_ASL";
+constexpr char probabilitiesTag[] = "PROBABILITIES";
+constexpr char classificationTag[] = "CLASSIFICATION";
+constexpr char multiClassificationTag[] = "MULTI_CLASSIFICATION";
+constexpr char metricsTag[] = "METRICS";
+constexpr char modelTag[] = "MODEL";
+constexpr char modelRegistryTag[] = "MODEL_REGISTRY";
+constexpr char defaultModelName[] = "default";
+constexpr char framesInferredCounter[] = "HandGestureRecognitionCalculator.FramesInferred";
+constexpr char framesSkippedCounter[] = "HandGestureRecognitionCalculator.FramesSkipped";
+constexpr char framesDroppedCounter[] = "HandGestureRecognitionCalculator.FramesDropped";
+constexpr char sequenceInferredCounter[] = "HandGestureRecognitionCalculator.SequenceInferred";
+constexpr char cascadeHitsCounter[] = "HandGestureRecognitionCalculator.CascadeHits";
+constexpr char cascadeMissesCounter[] = "HandGestureRecognitionCalculator.CascadeMisses";
+// Frames submitted to the async worker and not resolved yet: at most one
+// queued, one being classified and one whose result is on its way back.
+constexpr int kMaxFramesInFlight = 4;
 }
+
+// Classifies the ASL letter shown by a hand.
+//
+// Single-hand mode takes NORM_LANDMARKS and NORM_RECT and outputs a
+// GestureClassification (label index, calibrated confidence, top-k scores) on
+// CLASSIFICATION. Multi-hand mode takes the vectors produced by the multi hand
+// tracking graph on MULTI_NORM_LANDMARKS and MULTI_NORM_RECTS, classifies all
+// hands in one batched Invoke and outputs one GestureClassification per hand
+// on MULTI_CLASSIFICATION.
+//
+// Labels come from label_map_path, checked in Open() against the number of
+// classifier outputs, or from the `labels` characters. Confidences are
+// calibrated with confidence_temperature, see FillGestureClassification.
+//
+// The older text outputs, ASL and MULTI_ASL, are still available. The
+// single-hand ASL stream reuses one prebuilt packet per label, and
+// PROBABILITIES carries the raw classifier output. New graphs should convert
+// labels to text at the UI edge with GestureClassificationToStringCalculator.
+//
+// The classifier input is selected by `features`: the x/y z-scores the
+// bundled models were trained on, or the 3D invariant features of
+// ComputeInvariantFeatures, which undo the rect rotation, hand size and
+// handedness before the model sees the hand. The rules of RULES and CASCADE
+// mode always test the fingers on the canonical hand.
+//
+// Without a hand, only the first frame outputs the no-hand result (the
+// no_hand_label text, kNoHand classifications). The outputs then carry no
+// packets, only timestamp bound updates, until a hand comes back, so the
+// text and render calculators downstream stay idle; repeat_no_hand restores
+// a packet per frame. HandPresenceGateCalculator goes further and keeps
+// empty frames from reaching this calculator at all.
+//
+// Inference can be skipped while the hand is still or to stay within a
+// latency budget, see InferenceScheduler. Skipped frames repeat the previous
+// result. The FramesInferred and FramesSkipped counters report the ratio.
+//
+// The optional METRICS output carries a GestureMetrics every
+// metrics_dump_interval frames: stage duration histograms and no-hand,
+// low-confidence and fallback rule counters, aggregated since the previous
+// packet. Nothing is logged per frame.
+//
+// With async_inference, Process() only extracts the features and hands them
+// to a worker thread (AsyncGestureClassifier), so the graph thread never
+// waits for Invoke. A frame arriving while the worker is busy replaces the
+// one waiting, which is dropped (FramesDropped counter). Results are output
+// at the timestamp of their frame from the next Process() or from Close().
+// Meanwhile the timestamp bound of the result outputs stays at the oldest
+// frame still being classified, and moves on as soon as nothing is pending.
+// Frames that are dropped or skipped by the scheduler produce no packet.
+//
+// Per-hand state (motion baseline, smoothed features, last prediction and
+// sequence window) lives in a HandTrackTable. Hands are matched to their
+// track by rect center every frame, so the state follows each hand when the
+// hands are reordered, and survives short losses until the track is evicted.
+//
+// The `classifier` option selects who classifies the hands. In CASCADE mode
+// the cheap finger-state rules (gesture_rules.h) run first, and a hand they
+// clearly put on one of the trusted cascade_letters is settled without
+// Invoke. Only the other hands are batched for the model. The CascadeHits
+// and CascadeMisses counters, and the METRICS packets, give the share of
+// hands that skipped the model.
+//
+// Outside async mode the letter classifier comes from a
+// GestureModelRegistry: the one of the MODEL_REGISTRY side packet, shared
+// with the application, or one loaded from the `models` option. The optional
+// MODEL input stream switches the active model by name from its timestamp
+// on, and the application may Load() a new model under the active name at
+// any time. Each frame picks the current model up front and holds it until
+// the next one, so a model replaced meanwhile finishes the frame. A name the
+// registry does not have, or a model with other classes or input size than
+// the first one, is logged and ignored: the previous model keeps serving. A
+// shadow_model runs on the same batches to compare candidates under real
+// load; the per-model latency and agreement stats are logged in Close().
+//
+// J and Z are drawn in the air, which a single frame cannot show. With
+// sequence_model_path, every hand also keeps a LandmarkSequenceWindow of its
+// last sequence_window frames, and a temporal model classifies the window
+// whenever the letter classifier runs and the fingertips moved enough. A
+// confident motion letter replaces the letter of the single-frame model.
+//
+// All state lives in the calculator instance, so several instances, in one
+// graph or in graphs running side by side, can run concurrently.
+//
+// Example config:
+// node {
+//   calculator: "HandGestureRecognitionCalculator"
+//   input_stream: "MULTI_NORM_LANDMARKS:multi_hand_landmarks"
+//   input_stream: "MULTI_NORM_RECTS:multi_hand_rects"
+//   output_stream: "MULTI_CLASSIFICATION:multi_hand_letters"
+// }
 class HandGestureRecognitionCalculator : public CalculatorBase
 {
 public:
@@ -35,19 +155,202 @@ public:
     ::mediapipe::Status Open(CalculatorContext *cc) override;
 
     ::mediapipe::Status Process(CalculatorContext *cc) override;
+    ::mediapipe::Status Close(CalculatorContext *cc) override;
 private:
-    float get_Euclidean_DistanceAB(float a_x, float a_y, float b_x, float b_y)
+    ::mediapipe::Status processMultiHand(CalculatorContext *cc);
+    ::mediapipe::Status processAsync(CalculatorContext *cc);
+
+    // Outputs the latest result of the async worker, if any.
+    ::mediapipe::Status emitAsyncResult(CalculatorContext *cc);
+    void updateAsyncTimestampBounds(CalculatorContext *cc);
+
+    // Prebuilt text packet for a GestureClassification label.
+    const Packet &labelPacket(int label) const;
+
+    bool isHandPresent(const NormalizedRect &rect) const
     {
-        float dist = std::pow(a_x - b_x, 2) + pow(a_y - b_y, 2);
-        return std::sqrt(dist);
+        return rect.width() >= 0.01 && rect.height() >= 0.01;
     }
 
-    bool areLandmarksClose(NormalizedLandmark point1, NormalizedLandmark point2)
+    // Width over height of the image, from a hand rect: the hand tracking
+    // graphs make rects square in pixels.
+    float aspectRatio(const NormalizedRect &rect) const
     {
-        float distance = this->get_Euclidean_DistanceAB(point1.x(), point1.y(), point2.x(), point2.y());
-        return distance < 0.085;
+        return rect.height() / rect.width();
     }
 
+    // Landmark motion since the last inference, relative to the hand size.
+    float handMotion(const HandLandmarksSoA &hand, const HandLandmarksSoA &baseline,
+                     const NormalizedRect &rect) const
+    {
+        return MaxLandmarkDisplacement(hand, baseline) /
+               std::max(rect.width(), rect.height());
+    }
+
+    // Classifies a hand with the finger-state rules in RULES and CASCADE
+    // mode. Returns false when the model has to classify it instead: always
+    // in MODEL mode, and in CASCADE mode unless a trusted rule matched with
+    // enough margin. `classification` keeps its hand_id.
+    bool classifyByRules(CalculatorContext *cc, const HandLandmarksSoA &hand,
+                         const NormalizedRect &rect,
+                         GestureClassification *classification);
+
+    // Runs the classifier on the current input tensor and feeds the measured
+    // latency back to the scheduler. Then runs the shadow model, if any, on
+    // the same input.
+    ::mediapipe::Status invokeClassifier(CalculatorContext *cc);
+    ::mediapipe::Status compareShadowModel();
+
+    // Sets up registry_ and the active model in Open().
+    ::mediapipe::Status openModelRegistry(CalculatorContext *cc,
+                                          const GestureClassifier::Options &classifierOptions);
+    // Picks the models of the frame from the registry, following the MODEL
+    // input. A model that is missing or does not fit the labels and features
+    // of the first one is skipped with a warning, and the previous model
+    // keeps serving.
+    ::mediapipe::Status acquireModels(CalculatorContext *cc);
+    // Whether `model` has the classes and input size set up in Open().
+    bool modelFits(GestureModel &model) const;
+    // Whether the packet has no hand input, e.g. a MODEL packet alone.
+    bool handInputsEmpty(CalculatorContext *cc) const
+    {
+        if (cc->Inputs().HasTag(multiNormalizedLandmarkListTag))
+        {
+            return cc->Inputs().Tag(multiNormalizedLandmarkListTag).IsEmpty() ||
+                   cc->Inputs().Tag(multiNormRectTag).IsEmpty();
+        }
+        return cc->Inputs().Tag(normRectTag).IsEmpty();
+    }
+
+    // Matches the first `numHands` handCenters_ to their tracks, in
+    // handTracks_. Returns true if they are the hands of the last inference,
+    // in the same order.
+    bool assignTracks(int numHands);
+    HandTrack &handTrack(int k) { return tracks_->track(handTracks_[k]); }
+    // Remembers the hands of the current inference.
+    void recordInferredTracks(int numHands);
+
+    // Adds the k-th hand to its track's sequence window and returns its
+    // motion since the track's last inference, or max without one.
+    float updateTrack(int k, const HandLandmarksSoA &hand, const NormalizedRect &rect)
+    {
+        HandTrack &track = handTrack(k);
+        if (sequenceClassifier_)
+        {
+            track.window.Push(hand, std::max(rect.width(), rect.height()));
+        }
+        return track.has_baseline ? handMotion(hand, track.baseline, rect)
+                                  : std::numeric_limits<float>::max();
+    }
+
+    // Writes the classifier features of a hand, as selected by the
+    // `features` option, to `features`.
+    void computeFeatures(const HandLandmarksSoA &hand, const NormalizedRect &rect,
+                         float *features)
+    {
+        if (featureSet_ == HandGestureRecognitionCalculatorOptions::INVARIANT)
+        {
+            ComputeInvariantFeatures(hand, rect.rotation(), aspectRatio(rect), features);
+        }
+        else
+        {
+            ComputeZScoreFeatures(hand, features);
+        }
+    }
+
+    // Blends the classifier features of the k-th hand with those of its last
+    // inference, when feature_smoothing is set.
+    void smoothFeatures(int k, float *features);
+
+    // Runs the motion letter model on the window of the k-th hand and, if it
+    // recognizes a letter, puts it in `classification`.
+    ::mediapipe::Status applySequenceModel(CalculatorContext *cc, int k,
+                                           GestureClassification *classification);
+
+    // Counts the frame and, once per dump interval, outputs the metrics
+    // aggregated so far on METRICS.
+    void countFrame(CalculatorContext *cc);
+
+    // Models by name. Null in RULES and async mode.
+    std::shared_ptr<GestureModelRegistry> registry_;
+    std::string activeModelName_;
+    std::string shadowModelName_;
+    // Models of the current frame, kept until the next one, and the
+    // classifier of model_.
+    std::shared_ptr<GestureModel> model_;
+    std::shared_ptr<GestureModel> shadowModel_;
+    GestureClassifier *classifier_ = nullptr;
+    // The last models acquireModels() turned down, so each is warned about
+    // once.
+    std::shared_ptr<GestureModel> rejectedModel_;
+    std::shared_ptr<GestureModel> rejectedShadowModel_;
+    // Indices of the hands classified in the current batch.
+    std::vector<int> batchedHands_;
+    // Positions in batchedHands_ of the hands the rules left to the model.
+    std::vector<int> modelHands_;
+    // Async mode: their landmarks and rects, in batch order.
+    std::vector<const NormalizedLandmarkList *> batchedLandmarks_;
+    std::vector<const NormalizedRect *> batchedRects_;
+    HandLandmarksSoA handSoA_;
+    // The hand in its canonical frame, for the rules.
+    HandLandmarksSoA canonicalSoA_;
+
+    InferenceScheduler scheduler_{InferenceScheduler::Params()};
+    std::unique_ptr<HandTrackTable> tracks_;
+    // Rect centers and track slots of the hands in the current batch, and
+    // track ids of the hands of the last inference. Sized in Open().
+    std::vector<HandTrackTable::Center> handCenters_;
+    std::vector<int> handTracks_;
+    std::vector<int> inferredTrackIds_;
+    float featureSmoothing_ = 0;
+    // Whether the no-hand result of the current run of frames without a hand
+    // was output already.
+    bool noHandReported_ = false;
+    bool repeatNoHand_ = false;
+    HandGestureRecognitionCalculatorOptions::Features featureSet_ =
+        HandGestureRecognitionCalculatorOptions::ZSCORE;
+    // Floats per hand in the classifier input.
+    int featureSize_ = kZScoreFeatureSize;
+    HandGestureRecognitionCalculatorOptions::Classifier classifierMode_ =
+        HandGestureRecognitionCalculatorOptions::MODEL;
+    // Label of each rule of gesture_rules.h, kUnknownLabel for rules that are
+    // not trusted.
+    std::vector<int> ruleLabels_;
+    float cascadeMinMargin_ = 0;
+    int numClasses_ = 0;
+    int maxNumHands_ = 0;
+    float minConfidence_ = 0;
+    float confidenceTemperature_ = 1;
+    // One text packet per label, built in Open(), so that the ASL stream
+    // shares them instead of allocating a string per frame.
+    std::vector<Packet> labelPackets_;
+    Packet unknownLabelPacket_;
+    Packet noHandPacket_;
+
+    // Results of the last inference, re-emitted on skipped frames.
+    Packet lastASLPacket_;
+    Packet lastProbabilitiesPacket_;
+    Packet lastClassificationPacket_;
+    Packet lastMultiASLPacket_;
+    Packet lastMultiClassificationPacket_;
+
+    GestureMetrics metrics_;
+    int metricsDumpInterval_ = 0;
+
+    // Motion letter model, null without sequence_model_path.
+    // sequenceLabels_ maps its outputs to `labels` indices, -1 for "no
+    // motion letter". Letters missing from `labels` follow its last one.
+    std::unique_ptr<GestureClassifier> sequenceClassifier_;
+    std::vector<int> sequenceLabels_;
+    float sequenceMinConfidence_ = 0;
+    float sequenceMinPathLength_ = 0;
+
+    // Set in async mode, it then owns the classifier.
+    std::unique_ptr<AsyncGestureClassifier> asyncClassifier_;
+    // Timestamps of submitted frames that may still produce a result, oldest
+    // first.
+    std::array<Timestamp, kMaxFramesInFlight> framesInFlight_;
+    int numFramesInFlight_ = 0;
 };
 
 
@@ -56,6 +359,33 @@ REGISTER_CALCULATOR(HandGestureRecognitionCalculator);
 ::mediapipe::Status HandGestureRecognitionCalculator::GetContract(
     CalculatorContract *cc)
 {
+    if (cc->Outputs().HasTag(metricsTag)) {
+        cc->Outputs().Tag(metricsTag).Set<GestureMetrics>();
+    }
+    if (cc->Inputs().HasTag(modelTag)) {
+        cc->Inputs().Tag(modelTag).Set<std::string>();
+    }
+    if (cc->InputSidePackets().HasTag(modelRegistryTag)) {
+        cc->InputSidePackets().Tag(modelRegistryTag).Set<std::shared_ptr<GestureModelRegistry>>();
+    }
+    if (cc->Inputs().HasTag(multiNormalizedLandmarkListTag))
+    {
+        RET_CHECK(!cc->Inputs().HasTag(normalizedLandmarkListTag))
+            << "Use either NORM_LANDMARKS or MULTI_NORM_LANDMARKS.";
+        cc->Inputs().Tag(multiNormalizedLandmarkListTag).Set<std::vector<NormalizedLandmarkList>>();
+
+        RET_CHECK(cc->Inputs().HasTag(multiNormRectTag));
+        cc->Inputs().Tag(multiNormRectTag).Set<std::vector<NormalizedRect>>();
+
+        if (cc->Outputs().HasTag(multiClassificationTag)) {
+            cc->Outputs().Tag(multiClassificationTag).Set<std::vector<GestureClassification>>();
+        }
+        if (cc->Outputs().HasTag(multiASLTag)) {
+            cc->Outputs().Tag(multiASLTag).Set<std::vector<std::string>>();
+        }
+        return ::mediapipe::OkStatus();
+    }
+
     RET_CHECK(cc->Inputs().HasTag(normalizedLandmarkListTag));
     cc->Inputs().Tag(normalizedLandmarkListTag).Set<mediapipe::NormalizedLandmarkList>();
 
@@ -66,326 +396,1076 @@ REGISTER_CALCULATOR(HandGestureRecognitionCalculator);
     cc->Outputs().Tag("ASL").Set<std::string>();
 
   }
+    if (cc->Outputs().HasTag(probabilitiesTag)) {
+        cc->Outputs().Tag(probabilitiesTag).Set<std::vector<float>>();
+    }
+    if (cc->Outputs().HasTag(classificationTag)) {
+        cc->Outputs().Tag(classificationTag).Set<GestureClassification>();
+    }
     return ::mediapipe::OkStatus();
 }
 
 ::mediapipe::Status HandGestureRecognitionCalculator::Open(
     CalculatorContext *cc)
 {
-    cc->SetOffset(TimestampDiff(0));
-    return ::mediapipe::OkStatus();
-}
+    const auto &options =
+        cc->Options<::mediapipe::HandGestureRecognitionCalculatorOptions>();
+    if (!options.async_inference())
+    {
+        // Async results come later than their frame, bounds are set by hand.
+        cc->SetOffset(TimestampDiff(0));
+    }
+    GestureClassifier::Options classifierOptions;
+    classifierOptions.num_threads = options.num_threads();
+    switch (options.delegate())
+    {
+    case HandGestureRecognitionCalculatorOptions::NONE:
+        classifierOptions.delegate = GestureClassifier::Delegate::kNone;
+        break;
+    case HandGestureRecognitionCalculatorOptions::XNNPACK:
+        classifierOptions.delegate = GestureClassifier::Delegate::kXnnpack;
+        break;
+    case HandGestureRecognitionCalculatorOptions::NNAPI:
+        classifierOptions.delegate = GestureClassifier::Delegate::kNnapi;
+        break;
+    }
+    featureSet_ = options.features();
+    featureSize_ = featureSet_ == HandGestureRecognitionCalculatorOptions::INVARIANT
+                       ? kInvariantFeatureSize
+                       : kZScoreFeatureSize;
+    classifierOptions.feature_size = featureSize_;
+    classifierMode_ = options.classifier();
+    if (classifierMode_ != HandGestureRecognitionCalculatorOptions::MODEL)
+    {
+        RET_CHECK(!options.async_inference())
+            << "RULES and CASCADE are not supported with async_inference.";
+    }
+    std::unique_ptr<GestureClassifier> asyncModel;
+    if (classifierMode_ != HandGestureRecognitionCalculatorOptions::RULES)
+    {
+        if (options.async_inference())
+        {
+            RET_CHECK(!cc->InputSidePackets().HasTag(modelRegistryTag) &&
+                      !cc->Inputs().HasTag(modelTag) && options.models().empty())
+                << "Model registries are not supported with async_inference.";
+            ASSIGN_OR_RETURN(asyncModel,
+                             GestureClassifier::Create(options.model_path(),
+                                                       classifierOptions));
+            classifier_ = asyncModel.get();
+        }
+        else
+        {
+            MP_RETURN_IF_ERROR(openModelRegistry(cc, classifierOptions));
+        }
+        RET_CHECK_LE(classifier_->num_classes(), kMaxGestureClasses)
+            << "The letter classifier has more outputs than GestureClassification holds.";
+    }
 
-::mediapipe::Status HandGestureRecognitionCalculator::Process(
-    CalculatorContext *cc)
-{
-    // hand closed (red) rectangle
-    const auto rect = &(cc->Inputs().Tag(normRectTag).Get<NormalizedRect>());
-    float width = rect->width();
-    float height = rect->height();
+    minConfidence_ = options.min_confidence();
+    RET_CHECK_GT(options.confidence_temperature(), 0.f);
+    confidenceTemperature_ = options.confidence_temperature();
+    metricsDumpInterval_ = options.metrics_dump_interval();
+    std::vector<std::string> labels;
+    MP_RETURN_IF_ERROR(GetGestureLabels(options.label_map_path(), options.labels(),
+                                        classifier_ ? classifier_->num_classes() : 0,
+                                        &labels));
+    numClasses_ = classifier_ ? classifier_->num_classes()
+                              : std::min<int>(labels.size(), kMaxGestureClasses);
+    labelPackets_.clear();
+    for (const std::string &label : labels)
+    {
+        labelPackets_.push_back(MakePacket<std::string>(label));
+    }
+    unknownLabelPacket_ = MakePacket<std::string>(options.unknown_label());
+    noHandPacket_ = MakePacket<std::string>(options.no_hand_label());
+    maxNumHands_ = std::max(options.max_num_hands(), 1);
+    batchedHands_.reserve(maxNumHands_);
+    modelHands_.reserve(maxNumHands_);
 
-    if (width < 0.01 || height < 0.01)
+    ruleLabels_.assign(NumGestureRules(), GestureClassification::kUnknownLabel);
+    if (classifierMode_ != HandGestureRecognitionCalculatorOptions::MODEL)
     {
-        LOG(INFO) << "No Hand Detected";
-        if (cc->Outputs().HasTag("ASL")) {
-    cc->Outputs().Tag("ASL").AddPacket(
-        MakePacket<std::string>("No Hand Detected")
-            .At(cc->InputTimestamp()));
-           }
-        return ::mediapipe::OkStatus();
+        for (int rule = 0; rule < NumGestureRules(); rule++)
+        {
+            const std::string text = GestureRuleText(rule);
+            const bool trusted =
+                classifierMode_ == HandGestureRecognitionCalculatorOptions::RULES ||
+                (text.size() == 1 &&
+                 options.cascade_letters().find(text[0]) != std::string::npos);
+            const int index = std::find(labels.begin(), labels.end(), text) - labels.begin();
+            if (trusted && index < numClasses_)
+            {
+                ruleLabels_[rule] = index;
+            }
+        }
+        for (char letter : options.cascade_letters())
+        {
+            RET_CHECK(classifierMode_ != HandGestureRecognitionCalculatorOptions::CASCADE ||
+                      std::find(labels.begin(), labels.end(), std::string(1, letter)) !=
+                          labels.end())
+                << "Cascade letter " << letter << " is not in labels.";
+        }
+        cascadeMinMargin_ = options.cascade_min_margin();
     }
 
-    const auto &landmarkList = cc->Inputs()
-                                   .Tag(normalizedLandmarkListTag)
-                                   .Get<mediapipe::NormalizedLandmarkList>();
-    RET_CHECK_GT(landmarkList.landmark_size(), 0) << "Input landmark vector is empty.";
-    // finger states
-    bool thumbIsOpen = false;
-    bool firstFingerIsOpen = false;
-    bool secondFingerIsOpen = false;
-    bool thirdFingerIsOpen = false;
-    bool fourthFingerIsOpen = false;
+    InferenceScheduler::Params schedulerParams;
+    schedulerParams.motion_threshold = options.motion_threshold();
+    schedulerParams.min_frame_interval = options.min_frame_interval();
+    schedulerParams.max_frame_interval = options.max_frame_interval();
+    schedulerParams.inference_budget_us = options.inference_budget_us();
+    schedulerParams.max_skipped_frames = options.max_skipped_frames();
+    scheduler_ = InferenceScheduler(schedulerParams);
 
-    float pseudoFixKeyPoint = landmarkList.landmark(2).x();
-    if (landmarkList.landmark(3).x() < pseudoFixKeyPoint && landmarkList.landmark(4).x() < pseudoFixKeyPoint)
+    if (!options.sequence_model_path().empty())
     {
-        thumbIsOpen = true;
+        RET_CHECK(!options.async_inference())
+            << "sequence_model_path is not supported with async_inference.";
+        GestureClassifier::Options sequenceOptions = classifierOptions;
+        sequenceOptions.input_shape = {1, options.sequence_window(),
+                                       LandmarkSequenceWindow::kFrameSize};
+        ASSIGN_OR_RETURN(sequenceClassifier_,
+                         GestureClassifier::Create(options.sequence_model_path(),
+                                                   sequenceOptions));
+        RET_CHECK_EQ(sequenceClassifier_->num_classes(),
+                     static_cast<int>(options.sequence_labels().size()))
+            << "sequence_labels needs one character per sequence model output.";
+        sequenceLabels_.clear();
+        for (char label : options.sequence_labels())
+        {
+            if (label == ' ')
+            {
+                sequenceLabels_.push_back(-1);
+                continue;
+            }
+            // Motion letters the letter classifier has no output for get
+            // labels of their own after its outputs.
+            const std::string text(1, label);
+            const int index = std::find(labels.begin(), labels.end(), text) - labels.begin();
+            if (index == static_cast<int>(labels.size()))
+            {
+                labels.push_back(text);
+                labelPackets_.push_back(MakePacket<std::string>(text));
+            }
+            sequenceLabels_.push_back(index);
+        }
+        sequenceMinConfidence_ = options.sequence_min_confidence();
+        sequenceMinPathLength_ = options.sequence_min_path_length();
     }
 
-    pseudoFixKeyPoint = landmarkList.landmark(6).y();
-    if (landmarkList.landmark(7).y() < pseudoFixKeyPoint && landmarkList.landmark(8).y() < pseudoFixKeyPoint)
+    tracks_ = absl::make_unique<HandTrackTable>(
+        std::max(options.max_tracks(), maxNumHands_), options.track_match_distance(),
+        sequenceClassifier_ ? options.sequence_window() : 1);
+    handCenters_.resize(maxNumHands_);
+    handTracks_.resize(maxNumHands_);
+    inferredTrackIds_.reserve(maxNumHands_);
+    featureSmoothing_ = options.feature_smoothing();
+    repeatNoHand_ = options.repeat_no_hand();
+
+    if (options.async_inference())
     {
-        firstFingerIsOpen = true;
+        batchedLandmarks_.reserve(maxNumHands_);
+        batchedRects_.reserve(maxNumHands_);
+        asyncClassifier_ = absl::make_unique<AsyncGestureClassifier>(
+            std::move(asyncModel), maxNumHands_, minConfidence_,
+            confidenceTemperature_);
+        classifier_ = nullptr;
     }
+    return ::mediapipe::OkStatus();
+}
 
-    pseudoFixKeyPoint = landmarkList.landmark(10).y();
-    if (landmarkList.landmark(11).y() < pseudoFixKeyPoint && landmarkList.landmark(12).y() < pseudoFixKeyPoint)
+::mediapipe::Status HandGestureRecognitionCalculator::openModelRegistry(
+    CalculatorContext *cc, const GestureClassifier::Options &classifierOptions)
+{
+    const auto &options =
+        cc->Options<::mediapipe::HandGestureRecognitionCalculatorOptions>();
+    if (cc->InputSidePackets().HasTag(modelRegistryTag))
     {
-        secondFingerIsOpen = true;
+        registry_ = cc->InputSidePackets()
+                        .Tag(modelRegistryTag)
+                        .Get<std::shared_ptr<GestureModelRegistry>>();
+        RET_CHECK(registry_) << "MODEL_REGISTRY is null.";
     }
-
-    pseudoFixKeyPoint = landmarkList.landmark(14).y();
-    if (landmarkList.landmark(15).y() < pseudoFixKeyPoint && landmarkList.landmark(16).y() < pseudoFixKeyPoint)
+    else
+    {
+        GestureClassifier::Options registryOptions = classifierOptions;
+        registryOptions.memory_map = options.memory_map_models();
+        registry_ = std::make_shared<GestureModelRegistry>(registryOptions);
+        if (options.models().empty())
+        {
+            MP_RETURN_IF_ERROR(registry_->Load(defaultModelName, options.model_path()));
+        }
+        for (const auto &model : options.models())
+        {
+            MP_RETURN_IF_ERROR(registry_->Load(model.name(), model.path()));
+        }
+    }
+    activeModelName_ = options.active_model();
+    if (activeModelName_.empty())
     {
-        thirdFingerIsOpen = true;
+        activeModelName_ = options.models().empty() ? defaultModelName
+                                                    : options.models(0).name();
     }
+    shadowModelName_ = options.shadow_model();
+    model_ = registry_->Get(activeModelName_);
+    RET_CHECK(model_) << "The model registry has no model " << activeModelName_;
+    classifier_ = model_->classifier();
+    return ::mediapipe::OkStatus();
+}
 
-    pseudoFixKeyPoint = landmarkList.landmark(18).y();
-    if (landmarkList.landmark(19).y() < pseudoFixKeyPoint && landmarkList.landmark(20).y() < pseudoFixKeyPoint)
+bool HandGestureRecognitionCalculator::modelFits(GestureModel &model) const
+{
+    // The labels and features were set up for the first model in Open().
+    return model.classifier()->num_classes() == numClasses_ &&
+           model.classifier()->input_size() == featureSize_;
+}
+
+::mediapipe::Status HandGestureRecognitionCalculator::acquireModels(
+    CalculatorContext *cc)
+{
+    if (cc->Inputs().HasTag(modelTag) && !cc->Inputs().Tag(modelTag).IsEmpty())
     {
-        fourthFingerIsOpen = true;
+        const std::string &name = cc->Inputs().Tag(modelTag).Get<std::string>();
+        if (name != activeModelName_)
+        {
+            std::shared_ptr<GestureModel> model = registry_->Get(name);
+            if (!model)
+            {
+                LOG(WARNING) << "The model registry has no model " << name
+                             << "; keeping model " << activeModelName_;
+            }
+            else if (!modelFits(*model))
+            {
+                LOG(WARNING) << "Model " << name << " does not match model "
+                             << activeModelName_ << "; keeping it active";
+            }
+            else
+            {
+                activeModelName_ = name;
+            }
+        }
     }
+    // The registry may have reloaded or unloaded the model since the last
+    // frame. A model that no longer fits is not used; the previous one keeps
+    // serving until a valid one shows up.
+    std::shared_ptr<GestureModel> model = registry_->Get(activeModelName_);
+    if (model != model_)
+    {
+        if (model && modelFits(*model))
+        {
+            model_ = std::move(model);
+            rejectedModel_.reset();
+        }
+        else if (model != rejectedModel_)
+        {
+            LOG(WARNING) << "Model " << activeModelName_
+                         << (model ? " no longer matches" : " was unloaded")
+                         << "; keeping the previous one";
+            rejectedModel_ = std::move(model);
+        }
+    }
+    classifier_ = model_->classifier();
 
-    float x_mean = 0;
-    float x_sdev = 0;
-    float y_mean = 0;
-    float y_sdev = 0;
+    shadowModel_.reset();
+    if (!shadowModelName_.empty())
+    {
+        std::shared_ptr<GestureModel> shadowModel = registry_->Get(shadowModelName_);
+        if (shadowModel && shadowModel != model_)
+        {
+            if (modelFits(*shadowModel))
+            {
+                shadowModel_ = std::move(shadowModel);
+            }
+            else if (shadowModel != rejectedShadowModel_)
+            {
+                LOG(WARNING) << "Shadow model " << shadowModelName_
+                             << " does not match model " << activeModelName_
+                             << "; not comparing them";
+                rejectedShadowModel_ = std::move(shadowModel);
+            }
+        }
+    }
+    return ::mediapipe::OkStatus();
+}
 
+bool HandGestureRecognitionCalculator::classifyByRules(
+    CalculatorContext *cc, const HandLandmarksSoA &hand, const NormalizedRect &rect,
+    GestureClassification *classification)
+{
+    if (classifierMode_ == HandGestureRecognitionCalculatorOptions::MODEL)
+    {
+        return false;
+    }
+    // The finger tests assume an upright right hand.
+    CanonicalizeHand(hand, rect.rotation(), aspectRatio(rect), &canonicalSoA_);
+    const GestureRuleResult rule = EvaluateGestureRules(hand, canonicalSoA_);
+    const int label = rule.rule >= 0 ? ruleLabels_[rule.rule]
+                                     : GestureClassification::kUnknownLabel;
+    if (classifierMode_ == HandGestureRecognitionCalculatorOptions::CASCADE)
+    {
+        const float margin = rule.margin / std::max(rect.width(), rect.height());
+        if (label < 0 || margin < cascadeMinMargin_)
+        {
+            cc->GetCounter(cascadeMissesCounter)->Increment();
+            IncrementGestureMetric(&metrics_.cascade_misses);
+            return false;
+        }
+        cc->GetCounter(cascadeHitsCounter)->Increment();
+        IncrementGestureMetric(&metrics_.cascade_hits);
+    }
+    else
+    {
+        IncrementGestureMetric(&metrics_.fallback_frames);
+        if (label >= 0)
+        {
+            IncrementGestureMetric(&metrics_.fallback_rule_hits);
+        }
+    }
 
-    // Find mean
-    for(unsigned int i = 0; i < 21; i++){
-        x_mean += landmarkList.landmark(i).x();
-        y_mean += landmarkList.landmark(i).y();
+    // The rules are certain: all the probability goes to their letter.
+    classification->label = label;
+    classification->confidence = label >= 0 ? 1.f : 0.f;
+    classification->num_classes = numClasses_;
+    std::fill_n(classification->probabilities, numClasses_, 0.f);
+    for (int k = 0; k < kGestureTopK; k++)
+    {
+        classification->top_k_labels[k] = GestureClassification::kUnknownLabel;
+        classification->top_k_scores[k] = 0.f;
+    }
+    if (label >= 0)
+    {
+        classification->probabilities[label] = 1.f;
+        classification->top_k_labels[0] = label;
+        classification->top_k_scores[0] = 1.f;
     }
+    return true;
+}
 
-    x_mean /= 21.0;
-    y_mean /= 21.0;
+::mediapipe::Status HandGestureRecognitionCalculator::invokeClassifier(
+    CalculatorContext *cc)
+{
+    const absl::Time start = absl::Now();
+    MP_RETURN_IF_ERROR(model_->Invoke());
+    const absl::Duration latency = absl::Now() - start;
+    scheduler_.RecordInference(absl::ToInt64Microseconds(latency));
+    if (kGestureMetricsEnabled) {
+        metrics_.invoke.Add(absl::ToInt64Nanoseconds(latency));
+    }
+    cc->GetCounter(framesInferredCounter)->Increment();
+    return compareShadowModel();
+}
 
-    // Find sdev
-    // Σ(xi -mu)^2
-    for(unsigned int i = 0; i < 21; i++){
-        x_sdev += powf(landmarkList.landmark(i).x() - x_mean, 2.0);
-        y_sdev += powf(landmarkList.landmark(i).y() - y_mean, 2.0);
+::mediapipe::Status HandGestureRecognitionCalculator::compareShadowModel()
+{
+    if (!shadowModel_)
+    {
+        return ::mediapipe::OkStatus();
     }
+    GestureClassifier *shadow = shadowModel_->classifier();
+    const int batchSize = classifier_->batch_size();
+    MP_RETURN_IF_ERROR(shadow->ResizeBatch(batchSize));
+    std::copy_n(classifier_->input(), batchSize * featureSize_, shadow->input());
+    MP_RETURN_IF_ERROR(shadowModel_->Invoke());
 
-    // sqrt((Σ(xi -mu)^2) / N)
-    x_sdev = sqrtf(x_sdev);
-    y_sdev = sqrtf(y_sdev);
+    int agreements = 0;
+    for (int k = 0; k < batchSize; k++)
+    {
+        const float *scores = classifier_->output() + k * numClasses_;
+        const float *shadowScores = shadow->output() + k * numClasses_;
+        agreements += std::max_element(scores, scores + numClasses_) - scores ==
+                      std::max_element(shadowScores, shadowScores + numClasses_) - shadowScores;
+    }
+    shadowModel_->RecordComparison(batchSize, agreements);
+    return ::mediapipe::OkStatus();
+}
 
+::mediapipe::Status HandGestureRecognitionCalculator::applySequenceModel(
+    CalculatorContext *cc, int k, GestureClassification *classification)
+{
+    if (!sequenceClassifier_)
+    {
+        return ::mediapipe::OkStatus();
+    }
+    const LandmarkSequenceWindow &window = handTrack(k).window;
+    // A still hand cannot be drawing J or Z, the window is not worth a run.
+    if (!window.full() || window.tip_path_length() < sequenceMinPathLength_)
+    {
+        return ::mediapipe::OkStatus();
+    }
+    std::copy_n(window.data(), sequenceClassifier_->input_size(),
+                sequenceClassifier_->input());
+    MP_RETURN_IF_ERROR(sequenceClassifier_->Invoke());
+    cc->GetCounter(sequenceInferredCounter)->Increment();
 
-     // get z scores
-    std::vector<NormalizedLandmark> zscores;
-    float zscore_array[42] = {0};
-    for(unsigned int i = 0; i < 21; i++){
-        NormalizedLandmark scored = NormalizedLandmark();
-        scored.set_x((landmarkList.landmark(i).x() - x_mean) / x_sdev);
-        scored.set_y((landmarkList.landmark(i).y() - y_mean) / y_sdev);
+    GestureClassification motion;
+    FillGestureClassification(sequenceClassifier_->output(),
+                              sequenceClassifier_->num_classes(),
+                              sequenceMinConfidence_, &motion);
+    if (motion.label >= 0 && sequenceLabels_[motion.label] >= 0)
+    {
+        // Top-k and probabilities stay those of the letter classifier.
+        classification->label = sequenceLabels_[motion.label];
+        classification->confidence = motion.confidence;
+    }
+    return ::mediapipe::OkStatus();
+}
 
-        zscore_array[2*i] = (landmarkList.landmark(i).x() - x_mean) / x_sdev;
-        zscore_array[2*i + 1] = (landmarkList.landmark(i).y() - y_mean) / y_sdev;
+bool HandGestureRecognitionCalculator::assignTracks(int numHands)
+{
+    tracks_->Assign(handCenters_.data(), numHands, handTracks_.data());
+    if (numHands != static_cast<int>(inferredTrackIds_.size()))
+    {
+        return false;
+    }
+    for (int k = 0; k < numHands; k++)
+    {
+        if (handTrack(k).id != inferredTrackIds_[k])
+        {
+            return false;
+        }
+    }
+    return true;
+}
 
-//        zscores.push_back(scored);
+void HandGestureRecognitionCalculator::recordInferredTracks(int numHands)
+{
+    inferredTrackIds_.clear();
+    for (int k = 0; k < numHands; k++)
+    {
+        inferredTrackIds_.push_back(handTrack(k).id);
     }
+}
 
-    float maxprob = 0;
-    int maxindex = 24;
-    std::string model_path = "mediapipe/models/model_targeted_a.tflite";
-    ASSIGN_OR_RETURN(model_path, PathToResourceAsFile(model_path));
-    const char *filename = model_path.c_str();
-    std::unique_ptr<tflite::Interpreter> interpreter;
-    std::unique_ptr<tflite::FlatBufferModel> model = tflite::FlatBufferModel::BuildFromFile(filename);
-    int indexModel_Regular = 100;
-    if(indexModel_Regular==100){
-    if(model)
+void HandGestureRecognitionCalculator::smoothFeatures(int k, float *features)
+{
+    if (featureSmoothing_ <= 0.f)
+    {
+        return;
+    }
+    HandTrack &track = handTrack(k);
+    if (track.has_features)
     {
-        //  Build the interpreter
-        tflite::ops::builtin::BuiltinOpResolver resolver;
-        tflite::InterpreterBuilder(*model, resolver)(&interpreter);
-        interpreter->SetNumThreads(1);
-        indexModel_Regular = 0;
-        if(interpreter)
+        for (int i = 0; i < featureSize_; i++)
         {
-            std::vector<int> sizes = {42};
+            features[i] += featureSmoothing_ * (track.features[i] - features[i]);
+        }
+    }
+    std::copy_n(features, featureSize_, track.features);
+    track.has_features = true;
+}
 
-            // Resize input tensors, if desired.
-            interpreter->UseNNAPI(false);
+void HandGestureRecognitionCalculator::countFrame(CalculatorContext *cc)
+{
+    if (!kGestureMetricsEnabled)
+    {
+        return;
+    }
+    if (metricsDumpInterval_ > 0 && metrics_.frames >= metricsDumpInterval_)
+    {
+        if (cc->Outputs().HasTag(metricsTag)) {
+            cc->Outputs().Tag(metricsTag).AddPacket(
+                MakePacket<GestureMetrics>(metrics_).At(cc->InputTimestamp()));
+        }
+        metrics_.Reset();
+    }
+    ++metrics_.frames;
+}
 
-            int inputINT = interpreter->inputs()[0];
+::mediapipe::Status HandGestureRecognitionCalculator::Close(
+    CalculatorContext *cc)
+{
+    if (asyncClassifier_)
+    {
+        asyncClassifier_->Stop();
+        MP_RETURN_IF_ERROR(emitAsyncResult(cc));
+        asyncClassifier_.reset();
+    }
+    if (kGestureMetricsEnabled && metrics_.frames > 0)
+    {
+        LOG(INFO) << "HandGestureRecognitionCalculator metrics:\n"
+                  << metrics_.DebugString();
+    }
+    if (registry_)
+    {
+        LOG(INFO) << "HandGestureRecognitionCalculator models:\n"
+                  << registry_->DebugString();
+    }
+    classifier_ = nullptr;
+    model_.reset();
+    shadowModel_.reset();
+    rejectedModel_.reset();
+    rejectedShadowModel_.reset();
+    registry_.reset();
+    return ::mediapipe::OkStatus();
+}
 
-            interpreter->ResizeInputTensor(interpreter->inputs()[0], {42});
+::mediapipe::Status HandGestureRecognitionCalculator::Process(
+    CalculatorContext *cc)
+{
+    // A MODEL packet alone is not a frame.
+    if (!handInputsEmpty(cc))
+    {
+        countFrame(cc);
+    }
+    if (asyncClassifier_)
+    {
+        return processAsync(cc);
+    }
+    // Models may be shared with other calculators; they are used by one
+    // frame at a time. Both locks are taken in address order, so two
+    // calculators shadowing each other's model cannot deadlock.
+    absl::optional<absl::MutexLock> modelLock;
+    absl::optional<absl::MutexLock> shadowModelLock;
+    if (registry_)
+    {
+        MP_RETURN_IF_ERROR(acquireModels(cc));
+        absl::Mutex *first = model_->mutex();
+        absl::Mutex *second = shadowModel_ ? shadowModel_->mutex() : nullptr;
+        if (second != nullptr && second < first)
+        {
+            std::swap(first, second);
+        }
+        modelLock.emplace(first);
+        if (second != nullptr)
+        {
+            shadowModelLock.emplace(second);
+        }
+    }
+    if (cc->Inputs().HasTag(multiNormalizedLandmarkListTag))
+    {
+        return processMultiHand(cc);
+    }
+    if (cc->Inputs().Tag(normRectTag).IsEmpty())
+    {
+        // A MODEL packet alone.
+        return ::mediapipe::OkStatus();
+    }
 
-            interpreter->SetNumThreads(1);
-            indexModel_Regular = 0;
-            if(interpreter->AllocateTensors() == kTfLiteOk)
-               {
+    // hand closed (red) rectangle
+    const auto rect = &(cc->Inputs().Tag(normRectTag).Get<NormalizedRect>());
 
-                  const auto& input_indices = interpreter->inputs();
-                  for (int i = 0; i < 42; i++)
-                 {
-                    interpreter->typed_input_tensor<float>(0)[i] = zscore_array[i];
-                    LOG(INFO) << std::to_string(interpreter->typed_input_tensor<float>(0)[39]);
+    if (!isHandPresent(*rect))
+    {
+        scheduler_.Reset();
+        assignTracks(0);
+        inferredTrackIds_.clear();
+        IncrementGestureMetric(&metrics_.no_hand_frames);
+        if (noHandReported_ && !repeatNoHand_)
+        {
+            return ::mediapipe::OkStatus();
+        }
+        noHandReported_ = true;
+        if (cc->Outputs().HasTag("ASL")) {
+    cc->Outputs().Tag("ASL").AddPacket(
+        noHandPacket_.At(cc->InputTimestamp()));
+           }
+        if (cc->Outputs().HasTag(classificationTag)) {
+            GestureClassification noHand;
+            noHand.label = GestureClassification::kNoHand;
+            cc->Outputs().Tag(classificationTag).AddPacket(
+                MakePacket<GestureClassification>(noHand).At(cc->InputTimestamp()));
+        }
+        return ::mediapipe::OkStatus();
+    }
 
-                 }
-                    //LOG(INFO) << std::to_string(interpreter->typed_input_tensor<float>(0)[41]);
-                    indexModel_Regular = 0;
-                    if(interpreter->Invoke() == kTfLiteOk)
-                    {
-                        float* output = interpreter->typed_output_tensor<float>(0);
+    const auto &landmarkList = cc->Inputs()
+                                   .Tag(normalizedLandmarkListTag)
+                                   .Get<mediapipe::NormalizedLandmarkList>();
+    RET_CHECK_EQ(landmarkList.landmark_size(), kNumHandLandmarks)
+        << "A hand needs all its landmarks.";
+    noHandReported_ = false;
 
-                        if(output != 0)
-                        {
-                            indexModel_Regular = 100;
-                            for (int i = 0; i < 24; i++)
-                            {
-                                if (output[i] > maxprob)
-                                {
-                                    maxprob = output[i];
-                                    maxindex = i;
-                                }
-                            }
-                        }
-                    }
-               }
-          }
-    }
-       // std::string letters =  {'G', 'V', 'Y', 'A', 'E', 'L', 'R', 'W', 'Q', 'T', 'I', 'P', 'H', 'F', 'O', 'U', 'M', 'B', 'N', 'D', 'K', 'X', 'S', 'C', 'Z'};
-        std::string letters  =  {'A', 'B', 'C', 'D', 'E', 'F', 'G', 'H', 'I', 'J', 'K', 'L', 'M', 'N', 'O', 'P', 'Q', 'R', 'S', 'T', 'U', 'V', 'W', 'X', 'Y', 'Z'};
-
-            if (maxprob > 0.3)
-            {
-                ASL_Word = letters[maxindex];
-            }
-            else
-            {
-                ASL_Word = "Not a letter of the alphabet!";
-            }
+    handCenters_[0] = {rect->x_center(), rect->y_center()};
+    const bool sameHand = assignTracks(1);
+    ToHandLandmarksSoA(landmarkList.landmark(), &handSoA_);
+    const float trackMotion = updateTrack(0, handSoA_, *rect);
+    const float motion = sameHand ? trackMotion : std::numeric_limits<float>::max();
+    if (!sameHand)
+    {
+        // The last result is another track's letter. Forced even when the
+        // frame interval has not elapsed yet.
+        scheduler_.Reset();
+    }
+    if (!lastASLPacket_.IsEmpty() && !scheduler_.ShouldInfer(motion))
+    {
+        cc->GetCounter(framesSkippedCounter)->Increment();
+        IncrementGestureMetric(&metrics_.skipped_frames);
+        if (cc->Outputs().HasTag("ASL")) {
+            cc->Outputs().Tag("ASL").AddPacket(lastASLPacket_.At(cc->InputTimestamp()));
+        }
+        if (cc->Outputs().HasTag(probabilitiesTag) && !lastProbabilitiesPacket_.IsEmpty()) {
+            cc->Outputs().Tag(probabilitiesTag).AddPacket(
+                lastProbabilitiesPacket_.At(cc->InputTimestamp()));
+        }
+        if (cc->Outputs().HasTag(classificationTag) && !lastClassificationPacket_.IsEmpty()) {
+            cc->Outputs().Tag(classificationTag).AddPacket(
+                lastClassificationPacket_.At(cc->InputTimestamp()));
+        }
+        return ::mediapipe::OkStatus();
     }
-    //LOG(INFO) << maxprob;
-    else{
-        if (thumbIsOpen && firstFingerIsOpen && secondFingerIsOpen && thirdFingerIsOpen && fourthFingerIsOpen)
+    HandTrack &track = handTrack(0);
+    track.baseline = handSoA_;
+    track.has_baseline = true;
+    recordInferredTracks(1);
+
+    auto classification = absl::make_unique<GestureClassification>();
+    if (!classifyByRules(cc, handSoA_, *rect, classification.get()))
+    {
+        // The model may have run a batch for another calculator.
+        MP_RETURN_IF_ERROR(classifier_->ResizeBatch(1));
         {
-            ASL_Word = "C";
-            LOG(INFO) << "C - ASL Letter!!";
+            ScopedStageTimer timer(&metrics_.feature_extraction);
+            computeFeatures(handSoA_, *rect, classifier_->input());
+            smoothFeatures(0, classifier_->input());
         }
+        MP_RETURN_IF_ERROR(invokeClassifier(cc));
+        ScopedStageTimer timer(&metrics_.postprocessing);
+        const float *output = classifier_->output();
+        FillGestureClassification(output, classifier_->num_classes(),
+                                  minConfidence_, classification.get(),
+                                  confidenceTemperature_);
+        if (cc->Outputs().HasTag(probabilitiesTag)) {
+            lastProbabilitiesPacket_ =
+                MakePacket<std::vector<float>>(output, output + classifier_->num_classes());
+        }
+    }
+    else if (cc->Outputs().HasTag(probabilitiesTag))
+    {
+        lastProbabilitiesPacket_ = MakePacket<std::vector<float>>(
+            classification->probabilities,
+            classification->probabilities + classification->num_classes);
+    }
+    MP_RETURN_IF_ERROR(applySequenceModel(cc, 0, classification.get()));
+    track.classification = *classification;
+    if (classification->label == GestureClassification::kUnknownLabel)
+    {
+        IncrementGestureMetric(&metrics_.low_confidence_frames);
+    }
+    lastASLPacket_ = labelPacket(classification->label);
+    lastClassificationPacket_ = Adopt(classification.release());
+    if (cc->Outputs().HasTag(classificationTag)) {
+        cc->Outputs().Tag(classificationTag).AddPacket(
+            lastClassificationPacket_.At(cc->InputTimestamp()));
+    }
+    if (cc->Outputs().HasTag(probabilitiesTag)) {
+        cc->Outputs().Tag(probabilitiesTag).AddPacket(
+            lastProbabilitiesPacket_.At(cc->InputTimestamp()));
+    }
+    if (cc->Outputs().HasTag("ASL")) {
+    cc->Outputs().Tag("ASL").AddPacket(
+        lastASLPacket_.At(cc->InputTimestamp()));
+           }
+    return ::mediapipe::OkStatus();
+}
 
-        else if (!thumbIsOpen && firstFingerIsOpen && secondFingerIsOpen && thirdFingerIsOpen && fourthFingerIsOpen)
+::mediapipe::Status HandGestureRecognitionCalculator::processMultiHand(
+    CalculatorContext *cc)
+{
+    if (cc->Inputs().Tag(multiNormalizedLandmarkListTag).IsEmpty() ||
+        cc->Inputs().Tag(multiNormRectTag).IsEmpty())
+    {
+        return ::mediapipe::OkStatus();
+    }
+
+    const auto &hands = cc->Inputs()
+                            .Tag(multiNormalizedLandmarkListTag)
+                            .Get<std::vector<NormalizedLandmarkList>>();
+    const auto &rects = cc->Inputs()
+                            .Tag(multiNormRectTag)
+                            .Get<std::vector<NormalizedRect>>();
+    RET_CHECK_EQ(hands.size(), rects.size())
+        << "Every hand needs both its landmarks and its rect.";
+
+    batchedHands_.clear();
+    for (int i = 0; i < static_cast<int>(hands.size()) &&
+                    static_cast<int>(batchedHands_.size()) < maxNumHands_; i++)
+    {
+        if (isHandPresent(rects[i]) && hands[i].landmark_size() > 0)
         {
-            ASL_Word = "B";
-            LOG(INFO) << "B - ASL Letter!";
+            RET_CHECK_EQ(hands[i].landmark_size(), kNumHandLandmarks)
+                << "Hand " << i << " needs all its landmarks.";
+            batchedHands_.push_back(i);
         }
-        else if (!thumbIsOpen && firstFingerIsOpen && !secondFingerIsOpen && !thirdFingerIsOpen && !fourthFingerIsOpen)
+    }
+    if (batchedHands_.empty())
+    {
+        scheduler_.Reset();
+        IncrementGestureMetric(&metrics_.no_hand_frames);
+        if (noHandReported_ && !repeatNoHand_)
         {
+            assignTracks(0);
+            return ::mediapipe::OkStatus();
+        }
+    }
+    noHandReported_ = batchedHands_.empty();
 
-                ASL_Word = "D";
-                 LOG(INFO) << "D - ASL LETTER!";
+    for (int k = 0; k < static_cast<int>(batchedHands_.size()); k++)
+    {
+        const NormalizedRect &rect = rects[batchedHands_[k]];
+        handCenters_[k] = {rect.x_center(), rect.y_center()};
+    }
+    // The previous results can only be reused for the same hands in the same
+    // order; they are sized and numbered for the hands of the last inference.
+    // Other hands force inference, even when the frame interval has not
+    // elapsed yet.
+    const bool sameHands = assignTracks(batchedHands_.size());
+    if (!sameHands)
+    {
+        scheduler_.Reset();
+    }
+    float motion = sameHands ? 0.f : std::numeric_limits<float>::max();
+    for (int k = 0; k < static_cast<int>(batchedHands_.size()); k++)
+    {
+        ToHandLandmarksSoA(hands[batchedHands_[k]].landmark(), &handSoA_);
+        motion = std::max(motion, updateTrack(k, handSoA_, rects[batchedHands_[k]]));
+    }
+    if (!lastMultiClassificationPacket_.IsEmpty() && !scheduler_.ShouldInfer(motion))
+    {
+        cc->GetCounter(framesSkippedCounter)->Increment();
+        IncrementGestureMetric(&metrics_.skipped_frames);
+        if (cc->Outputs().HasTag(multiClassificationTag)) {
+            cc->Outputs().Tag(multiClassificationTag).AddPacket(
+                lastMultiClassificationPacket_.At(cc->InputTimestamp()));
+        }
+        if (cc->Outputs().HasTag(multiASLTag)) {
+            cc->Outputs().Tag(multiASLTag).AddPacket(
+                lastMultiASLPacket_.At(cc->InputTimestamp()));
         }
+        return ::mediapipe::OkStatus();
+    }
 
-        else if (!thumbIsOpen && firstFingerIsOpen && secondFingerIsOpen && !thirdFingerIsOpen && !fourthFingerIsOpen && this->areLandmarksClose(landmarkList.landmark(6), landmarkList.landmark(10)))
+    auto classifications =
+        absl::make_unique<std::vector<GestureClassification>>(hands.size());
+    for (int i = 0; i < static_cast<int>(hands.size()); i++)
+    {
+        (*classifications)[i].hand_id = i;
+        (*classifications)[i].label = GestureClassification::kNoHand;
+    }
+    modelHands_.clear();
+    for (int k = 0; k < static_cast<int>(batchedHands_.size()); k++)
+    {
+        HandTrack &track = handTrack(k);
+        ToHandLandmarksSoA(hands[batchedHands_[k]].landmark(), &track.baseline);
+        track.has_baseline = true;
+        if (!classifyByRules(cc, track.baseline, rects[batchedHands_[k]],
+                             &(*classifications)[batchedHands_[k]]))
         {
-            if (!(this->areLandmarksClose(landmarkList.landmark(12), landmarkList.landmark(8))))
-            {
-                ASL_Word = "U";
-                LOG(INFO) << "U - ASL Letter!";
-            }
-            else
-            {
-                ASL_Word = "R";
-                LOG(INFO) << "R - ASL Letter!";
-            }
+            modelHands_.push_back(k);
         }
-         else if (!thumbIsOpen && firstFingerIsOpen && secondFingerIsOpen && !thirdFingerIsOpen && !fourthFingerIsOpen)
+    }
+    if (!modelHands_.empty())
+    {
+        // The hands left to the model go through a single [N, features]
+        // Invoke.
+        MP_RETURN_IF_ERROR(classifier_->ResizeBatch(modelHands_.size()));
         {
-            if ((this->areLandmarksClose(landmarkList.landmark(4), landmarkList.landmark(6))))
+            ScopedStageTimer timer(&metrics_.feature_extraction);
+            float *input = classifier_->input();
+            for (int j = 0; j < static_cast<int>(modelHands_.size()); j++)
             {
-                ASL_Word = "K";
-                LOG(INFO) << "K - ASL Letter!";
-            }
-            else
-            {
-                ASL_Word = "V";
-                LOG(INFO) << "V - ASL Letter!";
+                const int k = modelHands_[j];
+                float *features = input + j * featureSize_;
+                computeFeatures(handTrack(k).baseline, rects[batchedHands_[k]], features);
+                smoothFeatures(k, features);
             }
         }
-        else if (!thumbIsOpen && firstFingerIsOpen && secondFingerIsOpen && thirdFingerIsOpen && !fourthFingerIsOpen)
+        MP_RETURN_IF_ERROR(invokeClassifier(cc));
+        ScopedStageTimer timer(&metrics_.postprocessing);
+        const float *output = classifier_->output();
+        for (int j = 0; j < static_cast<int>(modelHands_.size()); j++)
         {
-            ASL_Word = "W";
-            LOG(INFO) << "W - ASL Letter!";
+            FillGestureClassification(output + j * classifier_->num_classes(),
+                                      classifier_->num_classes(), minConfidence_,
+                                      &(*classifications)[batchedHands_[modelHands_[j]]],
+                                      confidenceTemperature_);
         }
+    }
+    for (int k = 0; k < static_cast<int>(batchedHands_.size()); k++)
+    {
+        GestureClassification &classification = (*classifications)[batchedHands_[k]];
+        MP_RETURN_IF_ERROR(applySequenceModel(cc, k, &classification));
+        handTrack(k).classification = classification;
+        if (classification.label == GestureClassification::kUnknownLabel)
+        {
+            IncrementGestureMetric(&metrics_.low_confidence_frames);
+        }
+    }
+
+    recordInferredTracks(batchedHands_.size());
 
-        else if (thumbIsOpen && firstFingerIsOpen && !secondFingerIsOpen && !thirdFingerIsOpen && fourthFingerIsOpen)
+    if (cc->Outputs().HasTag(multiASLTag)) {
+        auto letters = absl::make_unique<std::vector<std::string>>();
+        letters->reserve(classifications->size());
+        for (const auto &classification : *classifications)
         {
-             ASL_Word = "I LOVE YOU!";
-            LOG(INFO) << "I LOVE YOU!";
+            letters->push_back(labelPacket(classification.label).Get<std::string>());
         }
-        else if (thumbIsOpen && !firstFingerIsOpen && !secondFingerIsOpen && !thirdFingerIsOpen && fourthFingerIsOpen)
+        lastMultiASLPacket_ = Adopt(letters.release());
+    }
+    lastMultiClassificationPacket_ = Adopt(classifications.release());
+    if (cc->Outputs().HasTag(multiClassificationTag)) {
+        cc->Outputs().Tag(multiClassificationTag).AddPacket(
+            lastMultiClassificationPacket_.At(cc->InputTimestamp()));
+    }
+    if (cc->Outputs().HasTag(multiASLTag)) {
+        cc->Outputs().Tag(multiASLTag).AddPacket(
+            lastMultiASLPacket_.At(cc->InputTimestamp()));
+    }
+    return ::mediapipe::OkStatus();
+}
+
+::mediapipe::Status HandGestureRecognitionCalculator::processAsync(
+    CalculatorContext *cc)
+{
+    MP_RETURN_IF_ERROR(emitAsyncResult(cc));
+
+    int numInputHands = 1;
+    batchedHands_.clear();
+    batchedLandmarks_.clear();
+    batchedRects_.clear();
+    if (cc->Inputs().HasTag(multiNormalizedLandmarkListTag))
+    {
+        if (cc->Inputs().Tag(multiNormalizedLandmarkListTag).IsEmpty() ||
+            cc->Inputs().Tag(multiNormRectTag).IsEmpty())
         {
-            ASL_Word = "Y";
-            LOG(INFO) << "Y - ASL Letter!";
+            updateAsyncTimestampBounds(cc);
+            return ::mediapipe::OkStatus();
         }
-         else if (!thumbIsOpen && firstFingerIsOpen && !secondFingerIsOpen && !thirdFingerIsOpen && !fourthFingerIsOpen && this->areLandmarksClose(landmarkList.landmark(7), landmarkList.landmark(6)))
+        const auto &hands = cc->Inputs()
+                                .Tag(multiNormalizedLandmarkListTag)
+                                .Get<std::vector<NormalizedLandmarkList>>();
+        const auto &rects = cc->Inputs()
+                                .Tag(multiNormRectTag)
+                                .Get<std::vector<NormalizedRect>>();
+        RET_CHECK_EQ(hands.size(), rects.size())
+            << "Every hand needs both its landmarks and its rect.";
+        numInputHands = hands.size();
+        for (int i = 0; i < numInputHands &&
+                        static_cast<int>(batchedHands_.size()) < maxNumHands_; i++)
         {
-            ASL_Word = "X";
-            LOG(INFO) << "X - ASL LETTER!";
+            if (isHandPresent(rects[i]) && hands[i].landmark_size() > 0)
+            {
+                RET_CHECK_EQ(hands[i].landmark_size(), kNumHandLandmarks)
+                    << "Hand " << i << " needs all its landmarks.";
+                batchedHands_.push_back(i);
+                batchedLandmarks_.push_back(&hands[i]);
+                batchedRects_.push_back(&rects[i]);
+            }
         }
-        else if (thumbIsOpen && firstFingerIsOpen && secondFingerIsOpen && !thirdFingerIsOpen && !fourthFingerIsOpen && this->areLandmarksClose(landmarkList.landmark(4), landmarkList.landmark(6)))
+    }
+    else
+    {
+        const auto &rect = cc->Inputs().Tag(normRectTag).Get<NormalizedRect>();
+        if (isHandPresent(rect))
         {
-            ASL_Word = "P";
-            LOG(INFO) << "P - ASL LETTER!";
+            const auto &landmarkList = cc->Inputs()
+                                           .Tag(normalizedLandmarkListTag)
+                                           .Get<mediapipe::NormalizedLandmarkList>();
+            RET_CHECK_EQ(landmarkList.landmark_size(), kNumHandLandmarks)
+                << "A hand needs all its landmarks.";
+            batchedHands_.push_back(0);
+            batchedLandmarks_.push_back(&landmarkList);
+            batchedRects_.push_back(&rect);
         }
-        else if (!thumbIsOpen && !firstFingerIsOpen && !secondFingerIsOpen && !thirdFingerIsOpen && !fourthFingerIsOpen && (this-> areLandmarksClose(landmarkList.landmark(7), landmarkList.landmark(3))))
+    }
+
+    const int numHands = batchedHands_.size();
+    for (int k = 0; k < numHands; k++)
+    {
+        handCenters_[k] = {batchedRects_[k]->x_center(), batchedRects_[k]->y_center()};
+    }
+    const bool sameHands = assignTracks(numHands);
+    if (numHands == 0)
+    {
+        scheduler_.Reset();
+        IncrementGestureMetric(&metrics_.no_hand_frames);
+        if (noHandReported_ && !repeatNoHand_)
         {
-            ASL_Word = "S";
-            LOG(INFO) << "S - ASL LETTER!";
+            updateAsyncTimestampBounds(cc);
+            return ::mediapipe::OkStatus();
         }
-        else if (thumbIsOpen && !firstFingerIsOpen && !secondFingerIsOpen && !thirdFingerIsOpen && !fourthFingerIsOpen)
+    }
+    else if (sameHands)
+    {
+        float motion = 0.f;
+        for (int k = 0; k < numHands; k++)
         {
-            if(this->areLandmarksClose(landmarkList.landmark(4), landmarkList.landmark(9)))
-            {
-                 ASL_Word = "T";
-                 LOG(INFO) << "T - ASL LETTER!";
-            }
-            else if(this->areLandmarksClose(landmarkList.landmark(4), landmarkList.landmark(8)))
-            {
-                ASL_Word = "O";
-                 LOG(INFO) << "O - ASL LETTER!";
-            }
-            else
-            {
-                LOG(INFO) << "A - ASL LETTER!";
-                LOG(INFO) << "A - ASL LETTER!";
-                ASL_Word = "A";
-                //outputString = "A - ASL LETTER!";
-            }
+            ToHandLandmarksSoA(batchedLandmarks_[k]->landmark(), &handSoA_);
+            motion = std::max(motion, updateTrack(k, handSoA_, *batchedRects_[k]));
         }
-        else if (!thumbIsOpen && !firstFingerIsOpen && !secondFingerIsOpen && !thirdFingerIsOpen && fourthFingerIsOpen)
+        if (!scheduler_.ShouldInfer(motion))
         {
-            ASL_Word = "I";
-            LOG(INFO) << "I - ASL LETTER!";
+            cc->GetCounter(framesSkippedCounter)->Increment();
+            IncrementGestureMetric(&metrics_.skipped_frames);
+            updateAsyncTimestampBounds(cc);
+            return ::mediapipe::OkStatus();
         }
-        else if (!firstFingerIsOpen && secondFingerIsOpen && thirdFingerIsOpen && fourthFingerIsOpen && this->areLandmarksClose(landmarkList.landmark(4), landmarkList.landmark(8)))
+    }
+
+    // The first frame without hands goes through the worker as well, so that
+    // results stay in timestamp order.
+    noHandReported_ = numHands == 0;
+    AsyncGestureClassifier::Frame *frame = asyncClassifier_->input_frame();
+    frame->timestamp = cc->InputTimestamp().Value();
+    frame->num_input_hands = numInputHands;
+    frame->num_hands = numHands;
+    {
+        ScopedStageTimer timer(&metrics_.feature_extraction);
+        for (int k = 0; k < numHands; k++)
         {
-            ASL_Word = "F";
-            LOG(INFO) << "F - ASL LETTER!";
+            frame->hand_ids[k] = batchedHands_[k];
+            HandTrack &track = handTrack(k);
+            ToHandLandmarksSoA(batchedLandmarks_[k]->landmark(), &track.baseline);
+            track.has_baseline = true;
+            float *features = frame->features.data() + k * featureSize_;
+            computeFeatures(track.baseline, *batchedRects_[k], features);
+            smoothFeatures(k, features);
         }
-        else if (thumbIsOpen && firstFingerIsOpen && !secondFingerIsOpen && !thirdFingerIsOpen && !fourthFingerIsOpen)
+    }
+    recordInferredTracks(numHands);
+
+    int64_t droppedTimestamp = 0;
+    if (asyncClassifier_->Submit(&droppedTimestamp))
+    {
+        cc->GetCounter(framesDroppedCounter)->Increment();
+        int i = 0;
+        while (i < numFramesInFlight_ && framesInFlight_[i].Value() != droppedTimestamp)
         {
-            ASL_Word = "L";
-            LOG(INFO) << "L - ASL LETTER!";
+            i++;
         }
-        else if(!thumbIsOpen && !firstFingerIsOpen && !secondFingerIsOpen && !thirdFingerIsOpen && !fourthFingerIsOpen && !(this-> areLandmarksClose(landmarkList.landmark(7), landmarkList.landmark(3))))
+        if (i < numFramesInFlight_)
         {
-            ASL_Word = "E";
-            LOG(INFO) << "E - ASL LETTER!";
+            std::copy(framesInFlight_.begin() + i + 1,
+                      framesInFlight_.begin() + numFramesInFlight_,
+                      framesInFlight_.begin() + i);
+            numFramesInFlight_--;
         }
-        else if (thumbIsOpen && firstFingerIsOpen && secondFingerIsOpen && !thirdFingerIsOpen && !fourthFingerIsOpen)
+    }
+    RET_CHECK_LT(numFramesInFlight_, kMaxFramesInFlight);
+    framesInFlight_[numFramesInFlight_++] = cc->InputTimestamp();
+    updateAsyncTimestampBounds(cc);
+    return ::mediapipe::OkStatus();
+}
+
+::mediapipe::Status HandGestureRecognitionCalculator::emitAsyncResult(
+    CalculatorContext *cc)
+{
+    const AsyncGestureClassifier::Frame *result = asyncClassifier_->TakeResult();
+    if (result == nullptr)
+    {
+        return ::mediapipe::OkStatus();
+    }
+    MP_RETURN_IF_ERROR(result->status);
+    const Timestamp timestamp(result->timestamp);
+
+    // Results come in submission order: older frames still in flight were
+    // dropped along the way and will never produce one.
+    int resolved = 0;
+    while (resolved < numFramesInFlight_ && framesInFlight_[resolved] <= timestamp)
+    {
+        resolved++;
+    }
+    std::copy(framesInFlight_.begin() + resolved,
+              framesInFlight_.begin() + numFramesInFlight_,
+              framesInFlight_.begin());
+    numFramesInFlight_ -= resolved;
+
+    if (result->num_hands > 0)
+    {
+        cc->GetCounter(framesInferredCounter)->Increment();
+        scheduler_.RecordInference(result->invoke_ns / 1000);
+        if (kGestureMetricsEnabled) {
+            metrics_.invoke.Add(result->invoke_ns);
+            metrics_.postprocessing.Add(result->postprocessing_ns);
+        }
+        for (int k = 0; k < result->num_hands; k++)
         {
-            ASL_Word = "H";
-            LOG(INFO) << "H - ASL Letter!!";
+            if (result->classifications[k].label == GestureClassification::kUnknownLabel)
+            {
+                IncrementGestureMetric(&metrics_.low_confidence_frames);
+            }
         }
-        else
+    }
+
+    if (cc->Inputs().HasTag(multiNormalizedLandmarkListTag))
+    {
+        auto classifications =
+            absl::make_unique<std::vector<GestureClassification>>(result->num_input_hands);
+        for (int i = 0; i < result->num_input_hands; i++)
         {
-           ASL_Word = "Not in ASL";
-            LOG(INFO) << "Finger States: " << thumbIsOpen << firstFingerIsOpen << secondFingerIsOpen << thirdFingerIsOpen << fourthFingerIsOpen;
-            LOG(INFO) << "___";
+            (*classifications)[i].hand_id = i;
+            (*classifications)[i].label = GestureClassification::kNoHand;
+        }
+        for (int k = 0; k < result->num_hands; k++)
+        {
+            (*classifications)[result->hand_ids[k]] = result->classifications[k];
+        }
+        if (cc->Outputs().HasTag(multiASLTag)) {
+            auto letters = absl::make_unique<std::vector<std::string>>();
+            letters->reserve(classifications->size());
+            for (const auto &classification : *classifications)
+            {
+                letters->push_back(labelPacket(classification.label).Get<std::string>());
+            }
+            cc->Outputs().Tag(multiASLTag).Add(letters.release(), timestamp);
+        }
+        if (cc->Outputs().HasTag(multiClassificationTag)) {
+            cc->Outputs().Tag(multiClassificationTag).Add(
+                classifications.release(), timestamp);
         }
-    indexModel_Regular += 1;
+        return ::mediapipe::OkStatus();
     }
+
+    GestureClassification noHand;
+    noHand.label = GestureClassification::kNoHand;
+    const GestureClassification &classification =
+        result->num_hands > 0 ? result->classifications[0] : noHand;
     if (cc->Outputs().HasTag("ASL")) {
-    cc->Outputs().Tag("ASL").AddPacket(
-        MakePacket<std::string>(ASL_Word)
-            .At(cc->InputTimestamp()));
-           }
+        cc->Outputs().Tag("ASL").AddPacket(
+            labelPacket(classification.label).At(timestamp));
+    }
+    if (cc->Outputs().HasTag(classificationTag)) {
+        cc->Outputs().Tag(classificationTag).AddPacket(
+            MakePacket<GestureClassification>(classification).At(timestamp));
+    }
+    if (cc->Outputs().HasTag(probabilitiesTag) && result->num_hands > 0) {
+        cc->Outputs().Tag(probabilitiesTag).AddPacket(
+            MakePacket<std::vector<float>>(
+                classification.probabilities,
+                classification.probabilities + classification.num_classes)
+                .At(timestamp));
+    }
     return ::mediapipe::OkStatus();
-} // namespace mediapipe
+}
+
+void HandGestureRecognitionCalculator::updateAsyncTimestampBounds(
+    CalculatorContext *cc)
+{
+    const Timestamp next = cc->InputTimestamp().NextAllowedInStream();
+    // Results of the frames in flight will be output at their timestamps.
+    const Timestamp resultBound = numFramesInFlight_ > 0 ? framesInFlight_[0] : next;
+    for (const char *tag : {"ASL", probabilitiesTag, classificationTag,
+                            multiASLTag, multiClassificationTag})
+    {
+        if (cc->Outputs().HasTag(tag)) {
+            cc->Outputs().Tag(tag).SetNextTimestampBound(resultBound);
+        }
+    }
+    if (cc->Outputs().HasTag(metricsTag)) {
+        cc->Outputs().Tag(metricsTag).SetNextTimestampBound(next);
+    }
+}
+
+const Packet &HandGestureRecognitionCalculator::labelPacket(int label) const
+{
+    if (label == GestureClassification::kNoHand)
+    {
+        return noHandPacket_;
+    }
+    if (label < 0 || label >= static_cast<int>(labelPackets_.size()))
+    {
+        return unknownLabelPacket_;
+    }
+    return labelPackets_[label];
+}
 
 } // namespace mediapipe
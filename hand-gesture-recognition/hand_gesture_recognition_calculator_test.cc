@@ -0,0 +1,169 @@
+#include <random>
+#include <string>
+#include <vector>
+
+#include "absl/strings/str_cat.h"
+#include "mediapipe/framework/calculator_framework.h"
+#include "mediapipe/framework/formats/landmark.pb.h"
+#include "mediapipe/framework/formats/rect.pb.h"
+#include "mediapipe/framework/port/gtest.h"
+#include "mediapipe/framework/port/parse_text_proto.h"
+#include "mediapipe/framework/port/status_matchers.h"
+#include "mediapipe/framework/tool/sink.h"
+
+namespace mediapipe {
+namespace {
+
+constexpr int kNumFrames = 200;
+constexpr int kNumNodes = 4;
+constexpr int kNumLandmarks = 21;
+
+// One hand per frame, so every frame is classified by the bundled model and
+// each node outputs one letter and one score vector per frame.
+struct Frame {
+  NormalizedLandmarkList landmarks;
+  NormalizedRect rect;
+};
+
+// Random hands of a stream of its own, different for every `seed`.
+std::vector<Frame> MakeFrames(int seed) {
+  std::mt19937 random(seed);
+  std::uniform_real_distribution<float> coordinate(0.35f, 0.65f);
+  std::uniform_real_distribution<float> depth(-0.05f, 0.05f);
+  std::vector<Frame> frames(kNumFrames);
+  for (Frame& frame : frames) {
+    for (int i = 0; i < kNumLandmarks; ++i) {
+      NormalizedLandmark* landmark = frame.landmarks.add_landmark();
+      landmark->set_x(coordinate(random));
+      landmark->set_y(coordinate(random));
+      landmark->set_z(depth(random));
+    }
+    frame.rect.set_x_center(0.5f);
+    frame.rect.set_y_center(0.5f);
+    frame.rect.set_width(0.3f);
+    frame.rect.set_height(0.3f);
+  }
+  return frames;
+}
+
+struct Outputs {
+  std::vector<Packet> letters;
+  std::vector<Packet> probabilities;
+};
+
+// Appends one recognizer node reading `landmarks<i>` and `rect<i>` to
+// `config`, with its outputs collected in `outputs`.
+void AddRecognizerNode(int i, CalculatorGraphConfig* config,
+                       Outputs* outputs) {
+  const std::string suffix = absl::StrCat(i);
+  config->add_input_stream(absl::StrCat("landmarks", suffix));
+  config->add_input_stream(absl::StrCat("rect", suffix));
+  *config->add_node() = ParseTextProtoOrDie<CalculatorGraphConfig::Node>(
+      absl::StrCat(R"(
+        calculator: "HandGestureRecognitionCalculator"
+        input_stream: "NORM_LANDMARKS:landmarks)",
+                   suffix, R"("
+        input_stream: "NORM_RECT:rect)",
+                   suffix, R"("
+        output_stream: "ASL:letter)",
+                   suffix, R"("
+        output_stream: "PROBABILITIES:probabilities)",
+                   suffix, "\"\n"));
+  tool::AddVectorSink(absl::StrCat("letter", suffix), config,
+                      &outputs->letters);
+  tool::AddVectorSink(absl::StrCat("probabilities", suffix), config,
+                      &outputs->probabilities);
+}
+
+void AddFrame(int i, const Frame& frame, int64 timestamp_us,
+              CalculatorGraph* graph) {
+  const std::string suffix = absl::StrCat(i);
+  MP_ASSERT_OK(graph->AddPacketToInputStream(
+      absl::StrCat("landmarks", suffix),
+      MakePacket<NormalizedLandmarkList>(frame.landmarks)
+          .At(Timestamp(timestamp_us))));
+  MP_ASSERT_OK(graph->AddPacketToInputStream(
+      absl::StrCat("rect", suffix),
+      MakePacket<NormalizedRect>(frame.rect).At(Timestamp(timestamp_us))));
+}
+
+int64 FrameTimestamp(int frame) { return 33333 * (frame + 1); }
+
+// Outputs of a recognizer running alone on `frames`.
+Outputs RunAlone(const std::vector<Frame>& frames) {
+  CalculatorGraphConfig config;
+  Outputs outputs;
+  AddRecognizerNode(0, &config, &outputs);
+  CalculatorGraph graph;
+  MP_EXPECT_OK(graph.Initialize(config));
+  MP_EXPECT_OK(graph.StartRun({}));
+  for (int frame = 0; frame < kNumFrames; ++frame) {
+    AddFrame(0, frames[frame], FrameTimestamp(frame), &graph);
+  }
+  MP_EXPECT_OK(graph.CloseAllInputStreams());
+  MP_EXPECT_OK(graph.WaitUntilDone());
+  return outputs;
+}
+
+void ExpectSameOutputs(int node, const Outputs& actual,
+                       const Outputs& expected) {
+  ASSERT_EQ(actual.letters.size(), expected.letters.size()) << "node " << node;
+  ASSERT_EQ(actual.probabilities.size(), expected.probabilities.size())
+      << "node " << node;
+  for (size_t frame = 0; frame < actual.letters.size(); ++frame) {
+    EXPECT_EQ(actual.letters[frame].Timestamp(),
+              expected.letters[frame].Timestamp())
+        << "node " << node << " frame " << frame;
+    EXPECT_EQ(actual.letters[frame].Get<std::string>(),
+              expected.letters[frame].Get<std::string>())
+        << "node " << node << " frame " << frame;
+    EXPECT_EQ(actual.probabilities[frame].Get<std::vector<float>>(),
+              expected.probabilities[frame].Get<std::vector<float>>())
+        << "node " << node << " frame " << frame;
+  }
+}
+
+TEST(HandGestureRecognitionCalculatorTest, ConcurrentNodesKeepTheirOwnState) {
+  std::vector<std::vector<Frame>> frames;
+  std::vector<Outputs> expected;
+  for (int i = 0; i < kNumNodes; ++i) {
+    frames.push_back(MakeFrames(i + 1));
+    expected.push_back(RunAlone(frames[i]));
+    ASSERT_EQ(static_cast<int>(expected[i].letters.size()), kNumFrames);
+  }
+  // The streams must tell the nodes apart for a leak to show.
+  int num_differing_frames = 0;
+  for (int frame = 0; frame < kNumFrames; ++frame) {
+    if (expected[0].probabilities[frame].Get<std::vector<float>>() !=
+        expected[1].probabilities[frame].Get<std::vector<float>>()) {
+      ++num_differing_frames;
+    }
+  }
+  ASSERT_GT(num_differing_frames, 0);
+
+  // All nodes in one graph, on a default executor with a thread per node.
+  CalculatorGraphConfig config;
+  config.set_num_threads(kNumNodes);
+  std::vector<Outputs> outputs(kNumNodes);
+  for (int i = 0; i < kNumNodes; ++i) {
+    AddRecognizerNode(i, &config, &outputs[i]);
+  }
+  CalculatorGraph graph;
+  MP_ASSERT_OK(graph.Initialize(config));
+  MP_ASSERT_OK(graph.StartRun({}));
+  // Frames are interleaved across the nodes so that they run side by side.
+  for (int frame = 0; frame < kNumFrames; ++frame) {
+    for (int i = 0; i < kNumNodes; ++i) {
+      AddFrame(i, frames[i][frame], FrameTimestamp(frame), &graph);
+    }
+  }
+  MP_ASSERT_OK(graph.CloseAllInputStreams());
+  MP_ASSERT_OK(graph.WaitUntilDone());
+
+  for (int i = 0; i < kNumNodes; ++i) {
+    ExpectSameOutputs(i, outputs[i], expected[i]);
+  }
+}
+
+}  // namespace
+}  // namespace mediapipe
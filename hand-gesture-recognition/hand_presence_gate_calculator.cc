@@ -0,0 +1,142 @@
+#include <vector>
+
+#include "hand-gesture-recognition/hand_presence_gate_calculator.pb.h"
+#include "mediapipe/framework/calculator_framework.h"
+#include "mediapipe/framework/formats/rect.pb.h"
+#include "mediapipe/framework/port/ret_check.h"
+
+namespace mediapipe {
+
+namespace {
+
+constexpr char kNormRectTag[] = "NORM_RECT";
+constexpr char kMultiNormRectsTag[] = "MULTI_NORM_RECTS";
+constexpr char kPresenceTag[] = "PRESENCE";
+
+}  // namespace
+
+// Stops the packets of a gesture subgraph while no hand is in view, so that
+// the calculators downstream, HandGestureRecognitionCalculator first, are not
+// scheduled at all for empty frames.
+//
+// A hand is present when the NORM_RECT input, or one of the
+// MULTI_NORM_RECTS, is at least min_rect_size wide and high. The rect input
+// and the untagged inputs are then forwarded to the output with the same tag
+// or index. Without a hand, nothing is output and the outputs only advance
+// their timestamp bound. The optional PRESENCE output carries a bool on the
+// first frame and whenever hand presence changes, so that the UI can show
+// "no hand" once instead of on every frame.
+//
+// Example config:
+// node {
+//   calculator: "HandPresenceGateCalculator"
+//   input_stream: "NORM_RECT:hand_rect"
+//   input_stream: "hand_landmarks"
+//   output_stream: "NORM_RECT:gated_hand_rect"
+//   output_stream: "gated_hand_landmarks"
+//   output_stream: "PRESENCE:hand_presence"
+// }
+class HandPresenceGateCalculator : public CalculatorBase {
+ public:
+  static ::mediapipe::Status GetContract(CalculatorContract* cc);
+
+  ::mediapipe::Status Open(CalculatorContext* cc) override;
+
+  ::mediapipe::Status Process(CalculatorContext* cc) override;
+
+ private:
+  bool IsHandRect(const NormalizedRect& rect) const {
+    return rect.width() >= min_rect_size_ && rect.height() >= min_rect_size_;
+  }
+  bool IsHandPresent(CalculatorContext* cc) const;
+
+  bool multi_hand_ = false;
+  const char* rect_tag_ = kNormRectTag;
+  float min_rect_size_ = 0.f;
+  bool has_presence_ = false;
+  bool presence_ = false;
+};
+REGISTER_CALCULATOR(HandPresenceGateCalculator);
+
+::mediapipe::Status HandPresenceGateCalculator::GetContract(
+    CalculatorContract* cc) {
+  RET_CHECK(cc->Inputs().HasTag(kNormRectTag) !=
+            cc->Inputs().HasTag(kMultiNormRectsTag))
+      << "Use either NORM_RECT or MULTI_NORM_RECTS.";
+  if (cc->Inputs().HasTag(kNormRectTag)) {
+    cc->Inputs().Tag(kNormRectTag).Set<NormalizedRect>();
+    if (cc->Outputs().HasTag(kNormRectTag)) {
+      cc->Outputs().Tag(kNormRectTag).Set<NormalizedRect>();
+    }
+  } else {
+    cc->Inputs().Tag(kMultiNormRectsTag).Set<std::vector<NormalizedRect>>();
+    if (cc->Outputs().HasTag(kMultiNormRectsTag)) {
+      cc->Outputs().Tag(kMultiNormRectsTag).Set<std::vector<NormalizedRect>>();
+    }
+  }
+  RET_CHECK_EQ(cc->Inputs().NumEntries(""), cc->Outputs().NumEntries(""))
+      << "Every untagged input needs its output.";
+  for (int i = 0; i < cc->Inputs().NumEntries(""); ++i) {
+    cc->Inputs().Get("", i).SetAny();
+    cc->Outputs().Get("", i).SetSameAs(&cc->Inputs().Get("", i));
+  }
+  if (cc->Outputs().HasTag(kPresenceTag)) {
+    cc->Outputs().Tag(kPresenceTag).Set<bool>();
+  }
+  return ::mediapipe::OkStatus();
+}
+
+::mediapipe::Status HandPresenceGateCalculator::Open(CalculatorContext* cc) {
+  // Frames without a hand leave the outputs empty, the bounds still move on.
+  cc->SetOffset(TimestampDiff(0));
+  const auto& options = cc->Options<HandPresenceGateCalculatorOptions>();
+  min_rect_size_ = options.min_rect_size();
+  multi_hand_ = cc->Inputs().HasTag(kMultiNormRectsTag);
+  rect_tag_ = multi_hand_ ? kMultiNormRectsTag : kNormRectTag;
+  return ::mediapipe::OkStatus();
+}
+
+bool HandPresenceGateCalculator::IsHandPresent(CalculatorContext* cc) const {
+  const auto& input = cc->Inputs().Tag(rect_tag_);
+  if (input.IsEmpty()) {
+    return false;
+  }
+  if (!multi_hand_) {
+    return IsHandRect(input.Get<NormalizedRect>());
+  }
+  for (const auto& rect : input.Get<std::vector<NormalizedRect>>()) {
+    if (IsHandRect(rect)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+::mediapipe::Status HandPresenceGateCalculator::Process(
+    CalculatorContext* cc) {
+  const bool present = IsHandPresent(cc);
+  if (!has_presence_ || present != presence_) {
+    has_presence_ = true;
+    presence_ = present;
+    if (cc->Outputs().HasTag(kPresenceTag)) {
+      cc->Outputs().Tag(kPresenceTag).AddPacket(
+          MakePacket<bool>(present).At(cc->InputTimestamp()));
+    }
+  }
+  if (!present) {
+    return ::mediapipe::OkStatus();
+  }
+
+  if (cc->Outputs().HasTag(rect_tag_)) {
+    cc->Outputs().Tag(rect_tag_).AddPacket(cc->Inputs().Tag(rect_tag_).Value());
+  }
+  for (int i = 0; i < cc->Inputs().NumEntries(""); ++i) {
+    const auto& input = cc->Inputs().Get("", i);
+    if (!input.IsEmpty()) {
+      cc->Outputs().Get("", i).AddPacket(input.Value());
+    }
+  }
+  return ::mediapipe::OkStatus();
+}
+
+}  // namespace mediapipe
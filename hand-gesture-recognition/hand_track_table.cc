@@ -0,0 +1,91 @@
+#include "hand-gesture-recognition/hand_track_table.h"
+
+#include <algorithm>
+
+namespace mediapipe {
+
+void HandTrack::Reset() {
+  has_baseline = false;
+  has_features = false;
+  classification = GestureClassification();
+  window.Reset();
+}
+
+HandTrackTable::HandTrackTable(int capacity, float max_match_distance,
+                               int sequence_window)
+    : max_match_distance_(max_match_distance) {
+  capacity = std::max(capacity, 1);
+  tracks_.reserve(capacity);
+  for (int i = 0; i < capacity; ++i) {
+    tracks_.emplace_back(sequence_window);
+  }
+  matches_.reserve(capacity * capacity);
+  hand_matched_.resize(capacity);
+  slot_taken_.resize(capacity);
+}
+
+int HandTrackTable::NewTrackSlot(const std::vector<bool>& taken) const {
+  int best = -1;
+  for (int slot = 0; slot < capacity(); ++slot) {
+    if (taken[slot]) continue;
+    if (tracks_[slot].id < 0) return slot;
+    if (best < 0 || tracks_[slot].last_seen < tracks_[best].last_seen) {
+      best = slot;
+    }
+  }
+  return best;
+}
+
+void HandTrackTable::Assign(const Center* centers, int num_hands, int* slots) {
+  ++frame_;
+  num_hands = std::min(num_hands, capacity());
+  const float max_squared = max_match_distance_ * max_match_distance_;
+
+  matches_.clear();
+  for (int hand = 0; hand < num_hands; ++hand) {
+    for (int slot = 0; slot < capacity(); ++slot) {
+      const HandTrack& track = tracks_[slot];
+      if (track.id < 0) continue;
+      const float dx = centers[hand].x - track.center_x;
+      const float dy = centers[hand].y - track.center_y;
+      const float squared = dx * dx + dy * dy;
+      if (squared <= max_squared) {
+        matches_.push_back({squared, hand, slot});
+      }
+    }
+  }
+  std::sort(matches_.begin(), matches_.end(),
+            [](const Match& a, const Match& b) {
+              return a.distance < b.distance;
+            });
+
+  std::fill(hand_matched_.begin(), hand_matched_.end(), false);
+  std::fill(slot_taken_.begin(), slot_taken_.end(), false);
+  for (const Match& match : matches_) {
+    if (hand_matched_[match.hand] || slot_taken_[match.slot]) continue;
+    hand_matched_[match.hand] = true;
+    slot_taken_[match.slot] = true;
+    slots[match.hand] = match.slot;
+  }
+
+  for (int hand = 0; hand < num_hands; ++hand) {
+    if (!hand_matched_[hand]) {
+      const int slot = NewTrackSlot(slot_taken_);
+      slot_taken_[slot] = true;
+      slots[hand] = slot;
+      HandTrack& track = tracks_[slot];
+      track.Reset();
+      track.id = next_id_++;
+    }
+    HandTrack& track = tracks_[slots[hand]];
+    if (track.last_seen >= 0 && track.last_seen != frame_ - 1) {
+      // The window must hold consecutive frames.
+      track.window.Reset();
+    }
+    track.last_seen = frame_;
+    track.center_x = centers[hand].x;
+    track.center_y = centers[hand].y;
+  }
+}
+
+}  // namespace mediapipe
@@ -0,0 +1,98 @@
+#ifndef HAND_GESTURE_RECOGNITION_HAND_TRACK_TABLE_H_
+#define HAND_GESTURE_RECOGNITION_HAND_TRACK_TABLE_H_
+
+#include <cstdint>
+#include <vector>
+
+#include "hand-gesture-recognition/gesture_classification.h"
+#include "hand-gesture-recognition/landmark_features.h"
+#include "hand-gesture-recognition/landmark_sequence_window.h"
+
+namespace mediapipe {
+
+// Room for the larger of the classifier feature sets.
+constexpr int kMaxHandFeatureSize = kInvariantFeatureSize > kZScoreFeatureSize
+                                        ? kInvariantFeatureSize
+                                        : kZScoreFeatureSize;
+
+// Everything HandGestureRecognitionCalculator remembers about one hand.
+struct HandTrack {
+  explicit HandTrack(int sequence_window) : window(sequence_window) {}
+
+  // Forgets the previous hand, keeps the storage.
+  void Reset();
+
+  // Stable while the hand is tracked, never reused.
+  int id = -1;
+  // Frame the hand was last seen in, for LRU eviction.
+  int64_t last_seen = -1;
+  float center_x = 0.f;
+  float center_y = 0.f;
+
+  // Landmarks at the last inference, motion is measured against them.
+  HandLandmarksSoA baseline;
+  bool has_baseline = false;
+
+  // Exponentially smoothed classifier features, the first featureSize_ of
+  // the calculator are used.
+  float features[kMaxHandFeatureSize];
+  bool has_features = false;
+
+  // Last prediction. Not kept by the async mode, whose results come back
+  // after the tracks moved on.
+  GestureClassification classification;
+
+  // Recent frames for the motion letter model.
+  LandmarkSequenceWindow window;
+};
+
+// Assigns stable track ids to the hands of successive frames, so per-hand
+// state survives across frames and hand reordering.
+//
+// Each frame, hands are matched to the tracks with the nearest rect center,
+// closest pairs first, within `max_match_distance` (in normalized image
+// units). Unmatched hands start a new track in a free slot or, when all
+// `capacity` slots are taken, in the least recently seen one. A track coming
+// back after missing frames keeps its baseline and last prediction but
+// restarts its window. All tracks are allocated in the constructor.
+class HandTrackTable {
+ public:
+  struct Center {
+    float x;
+    float y;
+  };
+
+  HandTrackTable(int capacity, float max_match_distance, int sequence_window);
+
+  // Starts a new frame with the `num_hands` hands at `centers`, at most
+  // capacity() of them, and writes the track slot of each hand to `slots`.
+  void Assign(const Center* centers, int num_hands, int* slots);
+
+  HandTrack& track(int slot) { return tracks_[slot]; }
+  const HandTrack& track(int slot) const { return tracks_[slot]; }
+  int capacity() const { return tracks_.size(); }
+
+ private:
+  struct Match {
+    float distance;
+    int hand;
+    int slot;
+  };
+
+  // Slot for a new track, never one in `taken`.
+  int NewTrackSlot(const std::vector<bool>& taken) const;
+
+  float max_match_distance_;
+  std::vector<HandTrack> tracks_;
+  int64_t frame_ = 0;
+  int next_id_ = 0;
+
+  // Per-frame scratch, sized in the constructor.
+  std::vector<Match> matches_;
+  std::vector<bool> hand_matched_;
+  std::vector<bool> slot_taken_;
+};
+
+}  // namespace mediapipe
+
+#endif  // HAND_GESTURE_RECOGNITION_HAND_TRACK_TABLE_H_
@@ -0,0 +1,133 @@
+#include "hand-gesture-recognition/hand_track_table.h"
+
+#include <vector>
+
+#include "hand-gesture-recognition/landmark_features.h"
+#include "mediapipe/framework/port/gtest.h"
+
+namespace mediapipe {
+namespace {
+
+using Center = HandTrackTable::Center;
+
+constexpr float kMaxMatchDistance = 0.1f;
+
+std::vector<int> Assign(HandTrackTable* table,
+                        const std::vector<Center>& centers) {
+  std::vector<int> slots(centers.size(), -1);
+  table->Assign(centers.data(), centers.size(), slots.data());
+  return slots;
+}
+
+TEST(HandTrackTableTest, FollowsHandsWhenReordered) {
+  HandTrackTable table(2, kMaxMatchDistance, 1);
+  const std::vector<int> first = Assign(&table, {{0.2f, 0.5f}, {0.8f, 0.5f}});
+  ASSERT_NE(first[0], first[1]);
+  const int left_id = table.track(first[0]).id;
+  const int right_id = table.track(first[1]).id;
+  EXPECT_NE(left_id, right_id);
+
+  // Same hands, moved a little and listed the other way round.
+  const std::vector<int> second =
+      Assign(&table, {{0.78f, 0.52f}, {0.23f, 0.49f}});
+  EXPECT_EQ(second[0], first[1]);
+  EXPECT_EQ(second[1], first[0]);
+  EXPECT_EQ(table.track(second[0]).id, right_id);
+  EXPECT_EQ(table.track(second[1]).id, left_id);
+  EXPECT_FLOAT_EQ(table.track(second[0]).center_x, 0.78f);
+}
+
+TEST(HandTrackTableTest, ClosestHandWinsTheTrack) {
+  HandTrackTable table(2, kMaxMatchDistance, 1);
+  const int slot = Assign(&table, {{0.5f, 0.5f}})[0];
+  const int id = table.track(slot).id;
+
+  const std::vector<int> slots = Assign(&table, {{0.44f, 0.5f}, {0.52f, 0.5f}});
+  EXPECT_EQ(slots[1], slot);
+  EXPECT_EQ(table.track(slots[1]).id, id);
+  EXPECT_NE(slots[0], slot);
+  EXPECT_NE(table.track(slots[0]).id, id);
+}
+
+TEST(HandTrackTableTest, FarHandStartsANewTrack) {
+  HandTrackTable table(2, kMaxMatchDistance, 1);
+  const int slot = Assign(&table, {{0.2f, 0.2f}})[0];
+  const int id = table.track(slot).id;
+  table.track(slot).has_baseline = true;
+
+  const int moved = Assign(&table, {{0.6f, 0.6f}})[0];
+  EXPECT_NE(table.track(moved).id, id);
+  EXPECT_FALSE(table.track(moved).has_baseline);
+}
+
+TEST(HandTrackTableTest, FreeSlotsBeforeEviction) {
+  HandTrackTable table(3, kMaxMatchDistance, 1);
+  const std::vector<int> first = Assign(&table, {{0.1f, 0.5f}, {0.5f, 0.5f}});
+  // The first track is missing from this frame but a free slot is left.
+  const std::vector<int> second =
+      Assign(&table, {{0.5f, 0.5f}, {0.9f, 0.5f}});
+  EXPECT_EQ(second[0], first[1]);
+  EXPECT_NE(second[1], first[0]);
+  EXPECT_NE(second[1], first[1]);
+}
+
+TEST(HandTrackTableTest, EvictsTheLeastRecentlySeenTrack) {
+  HandTrackTable table(2, kMaxMatchDistance, 1);
+  const std::vector<int> first = Assign(&table, {{0.1f, 0.5f}, {0.5f, 0.5f}});
+  const int stale_id = table.track(first[0]).id;
+  table.track(first[0]).has_baseline = true;
+  table.track(first[0]).classification.label = 3;
+
+  Assign(&table, {{0.5f, 0.5f}});
+  // A new hand while both slots are taken replaces the track not seen in
+  // the last frame, and starts from a clean state.
+  const std::vector<int> third = Assign(&table, {{0.5f, 0.5f}, {0.9f, 0.5f}});
+  EXPECT_EQ(third[0], first[1]);
+  EXPECT_EQ(third[1], first[0]);
+  const HandTrack& evicted = table.track(third[1]);
+  EXPECT_NE(evicted.id, stale_id);
+  EXPECT_GT(evicted.id, stale_id);
+  EXPECT_FALSE(evicted.has_baseline);
+  EXPECT_EQ(evicted.classification.label,
+            GestureClassification::kUnknownLabel);
+}
+
+TEST(HandTrackTableTest, ReturningHandKeepsStateButRestartsWindow) {
+  constexpr int kSequenceWindow = 2;
+  HandTrackTable table(2, kMaxMatchDistance, kSequenceWindow);
+  HandLandmarksSoA hand = {};
+  const int slot = Assign(&table, {{0.5f, 0.5f}})[0];
+  const int id = table.track(slot).id;
+  for (int frame = 0; frame < kSequenceWindow; ++frame) {
+    if (frame > 0) Assign(&table, {{0.5f, 0.5f}});
+    table.track(slot).window.Push(hand, 0.2f);
+  }
+  table.track(slot).has_baseline = true;
+  table.track(slot).classification.label = 5;
+  ASSERT_TRUE(table.track(slot).window.full());
+
+  // Consecutive frames keep the window.
+  EXPECT_EQ(Assign(&table, {{0.51f, 0.5f}})[0], slot);
+  EXPECT_TRUE(table.track(slot).window.full());
+
+  // The hand is lost for a frame, then comes back near where it was.
+  Assign(&table, {});
+  EXPECT_EQ(Assign(&table, {{0.52f, 0.5f}})[0], slot);
+  const HandTrack& track = table.track(slot);
+  EXPECT_EQ(track.id, id);
+  EXPECT_TRUE(track.has_baseline);
+  EXPECT_EQ(track.classification.label, 5);
+  EXPECT_FALSE(track.window.full());
+}
+
+TEST(HandTrackTableTest, ExtraHandsAreIgnored) {
+  HandTrackTable table(1, kMaxMatchDistance, 1);
+  std::vector<int> slots = {-1, -1};
+  const std::vector<Center> centers = {{0.2f, 0.5f}, {0.8f, 0.5f}};
+  table.Assign(centers.data(), 2, slots.data());
+  EXPECT_EQ(slots[0], 0);
+  EXPECT_EQ(slots[1], -1);
+}
+
+}  // namespace
+}  // namespace mediapipe
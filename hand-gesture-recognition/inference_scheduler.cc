@@ -0,0 +1,46 @@
+#include "hand-gesture-recognition/inference_scheduler.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace mediapipe {
+
+InferenceScheduler::InferenceScheduler(const Params& params)
+    : params_(params) {
+  params_.min_frame_interval = std::max(params_.min_frame_interval, 1);
+  params_.max_frame_interval =
+      std::max(params_.max_frame_interval, params_.min_frame_interval);
+  frame_interval_ = params_.min_frame_interval;
+  Reset();
+}
+
+void InferenceScheduler::Reset() {
+  frames_since_inference_ = std::numeric_limits<int>::max() / 2;
+}
+
+bool InferenceScheduler::ShouldInfer(float motion) {
+  ++frames_since_inference_;
+  bool infer = frames_since_inference_ >= frame_interval_;
+  if (infer && params_.motion_threshold > 0.f &&
+      motion < params_.motion_threshold &&
+      frames_since_inference_ <= params_.max_skipped_frames) {
+    infer = false;
+  }
+  if (infer) {
+    frames_since_inference_ = 0;
+  }
+  return infer;
+}
+
+void InferenceScheduler::RecordInference(int64_t latency_us) {
+  if (params_.inference_budget_us <= 0) {
+    return;
+  }
+  if (latency_us > params_.inference_budget_us) {
+    frame_interval_ = std::min(frame_interval_ + 1, params_.max_frame_interval);
+  } else if (latency_us < params_.inference_budget_us / 2) {
+    frame_interval_ = std::max(frame_interval_ - 1, params_.min_frame_interval);
+  }
+}
+
+}  // namespace mediapipe
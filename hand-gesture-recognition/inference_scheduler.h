@@ -0,0 +1,53 @@
+#ifndef HAND_GESTURE_RECOGNITION_INFERENCE_SCHEDULER_H_
+#define HAND_GESTURE_RECOGNITION_INFERENCE_SCHEDULER_H_
+
+#include <cstdint>
+
+namespace mediapipe {
+
+// Decides per frame whether the letter classifier has to run or whether the
+// previous result can be reused.
+//
+// A frame is skipped when the hand barely moved since the last inference, or
+// when fewer than frame_interval() frames went by since it. The interval
+// starts at `min_frame_interval` and adapts to the measured Invoke latency:
+// it grows while inference exceeds `inference_budget_us` and shrinks back
+// once it fits again, never beyond `max_frame_interval`.
+class InferenceScheduler {
+ public:
+  struct Params {
+    // Motion below this never triggers inference on its own. 0 disables
+    // motion based skipping.
+    float motion_threshold = 0.f;
+    int min_frame_interval = 1;
+    int max_frame_interval = 1;
+    // 0 disables the latency budget.
+    int64_t inference_budget_us = 0;
+    // Inference runs at least once every this many frames, even without
+    // motion, so a stale result cannot stick forever.
+    int max_skipped_frames = 15;
+  };
+
+  explicit InferenceScheduler(const Params& params);
+
+  // `motion` is how far the hand moved since the last inference, in hand
+  // sizes. Returns true if the classifier should run on this frame.
+  bool ShouldInfer(float motion);
+
+  // Reports the latency of the inference ShouldInfer() asked for.
+  void RecordInference(int64_t latency_us);
+
+  // Forces inference on the next frame, e.g. after the hand was lost.
+  void Reset();
+
+  int frame_interval() const { return frame_interval_; }
+
+ private:
+  Params params_;
+  int frame_interval_;
+  int frames_since_inference_;
+};
+
+}  // namespace mediapipe
+
+#endif  // HAND_GESTURE_RECOGNITION_INFERENCE_SCHEDULER_H_
@@ -0,0 +1,115 @@
+#include "hand-gesture-recognition/landmark_dataset.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <cstring>
+
+#include "absl/memory/memory.h"
+#include "mediapipe/framework/port/ret_check.h"
+
+namespace mediapipe {
+
+namespace {
+
+struct FileCloser {
+  void operator()(std::FILE* file) const { std::fclose(file); }
+};
+using File = std::unique_ptr<std::FILE, FileCloser>;
+
+}  // namespace
+
+::mediapipe::Status WriteLandmarkDataset(const std::string& path,
+                                         const std::vector<int32_t>& labels,
+                                         const std::vector<float>& landmarks) {
+  RET_CHECK_EQ(landmarks.size(), labels.size() * kLandmarkDatasetRowSize)
+      << "Every label needs " << kLandmarkDatasetRowSize << " coordinates.";
+  File file(std::fopen(path.c_str(), "wb"));
+  RET_CHECK(file) << "Cannot open " << path << " for writing.";
+  LandmarkDatasetHeader header;
+  std::memcpy(header.magic, kLandmarkDatasetMagic, sizeof(header.magic));
+  header.version = kLandmarkDatasetVersion;
+  header.num_landmarks = kNumHandLandmarks;
+  header.reserved = 0;
+  header.num_samples = labels.size();
+  RET_CHECK_EQ(std::fwrite(&header, sizeof(header), 1, file.get()), 1u);
+  RET_CHECK_EQ(std::fwrite(labels.data(), sizeof(int32_t), labels.size(),
+                           file.get()),
+               labels.size());
+  RET_CHECK_EQ(std::fwrite(landmarks.data(), sizeof(float), landmarks.size(),
+                           file.get()),
+               landmarks.size());
+  RET_CHECK_EQ(std::fflush(file.get()), 0) << "Failed to write " << path;
+  return ::mediapipe::OkStatus();
+}
+
+::mediapipe::StatusOr<std::unique_ptr<LandmarkDataset>> LandmarkDataset::Open(
+    const std::string& path) {
+  const int fd = open(path.c_str(), O_RDONLY);
+  RET_CHECK_GE(fd, 0) << "Failed to open " << path;
+  struct stat file_stat;
+  const bool stat_ok = fstat(fd, &file_stat) == 0;
+  void* mapping = MAP_FAILED;
+  if (stat_ok && file_stat.st_size > 0) {
+    mapping = mmap(nullptr, file_stat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  }
+  // The mapping stays valid once the file is closed.
+  close(fd);
+  RET_CHECK(mapping != MAP_FAILED) << "Failed to map " << path;
+
+  auto dataset = absl::WrapUnique(new LandmarkDataset());
+  dataset->mapping_ = mapping;
+  dataset->mapping_size_ = file_stat.st_size;
+  // Samples are mostly read front to back, let the kernel read ahead.
+  madvise(mapping, dataset->mapping_size_, MADV_SEQUENTIAL);
+
+  RET_CHECK_GE(dataset->mapping_size_, sizeof(LandmarkDatasetHeader))
+      << path << " is not a landmark dataset.";
+  const auto* header = static_cast<const LandmarkDatasetHeader*>(mapping);
+  RET_CHECK(std::memcmp(header->magic, kLandmarkDatasetMagic,
+                        sizeof(header->magic)) == 0)
+      << path << " is not a landmark dataset.";
+  RET_CHECK_EQ(header->version, kLandmarkDatasetVersion);
+  RET_CHECK_EQ(header->num_landmarks,
+               static_cast<uint32_t>(kNumHandLandmarks));
+  const uint64_t num_samples = header->num_samples;
+  const uint64_t sample_size =
+      sizeof(int32_t) + kLandmarkDatasetRowSize * sizeof(float);
+  // Divided rather than multiplied, so a corrupt count cannot overflow.
+  const uint64_t data_size =
+      dataset->mapping_size_ - sizeof(LandmarkDatasetHeader);
+  RET_CHECK(data_size % sample_size == 0 &&
+            data_size / sample_size == num_samples)
+      << path << " does not hold " << num_samples << " samples.";
+
+  dataset->num_samples_ = num_samples;
+  dataset->labels_ = reinterpret_cast<const int32_t*>(header + 1);
+  dataset->landmarks_ =
+      reinterpret_cast<const float*>(dataset->labels_ + num_samples);
+  return dataset;
+}
+
+LandmarkDataset::~LandmarkDataset() {
+  if (mapping_ != nullptr) {
+    munmap(mapping_, mapping_size_);
+  }
+}
+
+void LandmarkDataset::GetHand(int64_t sample, HandLandmarksSoA* hand) const {
+  const float* row = landmarks(sample);
+  for (int i = 0; i < kNumHandLandmarks; ++i) {
+    hand->x[i] = row[3 * i];
+    hand->y[i] = row[3 * i + 1];
+    hand->z[i] = row[3 * i + 2];
+  }
+  for (int i = kNumHandLandmarks; i < kPaddedHandLandmarks; ++i) {
+    hand->x[i] = 0.f;
+    hand->y[i] = 0.f;
+    hand->z[i] = 0.f;
+  }
+}
+
+}  // namespace mediapipe
@@ -0,0 +1,85 @@
+#ifndef HAND_GESTURE_RECOGNITION_LANDMARK_DATASET_H_
+#define HAND_GESTURE_RECOGNITION_LANDMARK_DATASET_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "hand-gesture-recognition/landmark_features.h"
+#include "mediapipe/framework/port/status.h"
+#include "mediapipe/framework/port/statusor.h"
+
+namespace mediapipe {
+
+// Labeled single-hand poses for offline classification, e.g. re-scoring a
+// recorded corpus with a retrained model.
+//
+// A dataset file is a LandmarkDatasetHeader followed by two columns, in
+// native byte order: num_samples int32 labels, then num_samples rows of
+// x, y, z for each of the num_landmarks landmarks. Keeping the labels apart
+// lets them be validated and counted without paging in the landmarks.
+
+constexpr char kLandmarkDatasetMagic[4] = {'H', 'G', 'D', 'S'};
+constexpr uint32_t kLandmarkDatasetVersion = 1;
+// Label of a sample without ground truth.
+constexpr int32_t kUnlabeledSample = -1;
+
+struct LandmarkDatasetHeader {
+  char magic[4];
+  uint32_t version;
+  uint32_t num_landmarks;
+  uint32_t reserved;
+  uint64_t num_samples;
+};
+
+static_assert(sizeof(LandmarkDatasetHeader) == 24,
+              "Unexpected header padding.");
+
+// Floats per sample in the landmark column.
+constexpr int kLandmarkDatasetRowSize = 3 * kNumHandLandmarks;
+
+// Writes a dataset. `landmarks` holds kLandmarkDatasetRowSize floats per
+// label.
+::mediapipe::Status WriteLandmarkDataset(const std::string& path,
+                                         const std::vector<int32_t>& labels,
+                                         const std::vector<float>& landmarks);
+
+// Read-only, memory-mapped dataset. Samples can be read from any number of
+// threads at once.
+class LandmarkDataset {
+ public:
+  // Maps the dataset at `path` and checks that its size matches the header.
+  static ::mediapipe::StatusOr<std::unique_ptr<LandmarkDataset>> Open(
+      const std::string& path);
+  ~LandmarkDataset();
+
+  LandmarkDataset(const LandmarkDataset&) = delete;
+  LandmarkDataset& operator=(const LandmarkDataset&) = delete;
+
+  int64_t num_samples() const { return num_samples_; }
+  const int32_t* labels() const { return labels_; }
+  int32_t label(int64_t sample) const { return labels_[sample]; }
+
+  // The kLandmarkDatasetRowSize landmark coordinates of `sample`.
+  const float* landmarks(int64_t sample) const {
+    return landmarks_ + sample * kLandmarkDatasetRowSize;
+  }
+
+  // Loads `sample` into the layout of the feature kernels.
+  void GetHand(int64_t sample, HandLandmarksSoA* hand) const;
+
+ private:
+  LandmarkDataset() = default;
+
+  void* mapping_ = nullptr;
+  size_t mapping_size_ = 0;
+  int64_t num_samples_ = 0;
+  const int32_t* labels_ = nullptr;
+  const float* landmarks_ = nullptr;
+};
+
+}  // namespace mediapipe
+
+#endif  // HAND_GESTURE_RECOGNITION_LANDMARK_DATASET_H_
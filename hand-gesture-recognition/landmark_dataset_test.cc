@@ -0,0 +1,129 @@
+#include "hand-gesture-recognition/landmark_dataset.h"
+
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "mediapipe/framework/port/gtest.h"
+#include "mediapipe/framework/port/status_matchers.h"
+
+namespace mediapipe {
+namespace {
+
+constexpr int kNumSamples = 5;
+
+std::string TempPath(const std::string& name) {
+  return ::testing::TempDir() + "/" + name;
+}
+
+std::vector<int32_t> TestLabels() { return {3, kUnlabeledSample, 0, 23, 7}; }
+
+std::vector<float> TestLandmarks() {
+  std::vector<float> landmarks(kNumSamples * kLandmarkDatasetRowSize);
+  for (size_t i = 0; i < landmarks.size(); ++i) {
+    landmarks[i] = 0.001f * i;
+  }
+  return landmarks;
+}
+
+// The bytes of a valid dataset, for corrupting them.
+std::string TestFile() {
+  const std::string path = TempPath("test.hgds");
+  EXPECT_TRUE(WriteLandmarkDataset(path, TestLabels(), TestLandmarks()).ok());
+  std::ifstream file(path, std::ios::binary);
+  return std::string(std::istreambuf_iterator<char>(file),
+                     std::istreambuf_iterator<char>());
+}
+
+std::string WriteFile(const std::string& name, const std::string& contents) {
+  const std::string path = TempPath(name);
+  std::ofstream file(path, std::ios::binary);
+  file.write(contents.data(), contents.size());
+  return path;
+}
+
+TEST(LandmarkDatasetTest, RoundTrips) {
+  const std::string path = TempPath("round_trip.hgds");
+  const std::vector<int32_t> labels = TestLabels();
+  const std::vector<float> landmarks = TestLandmarks();
+  MP_ASSERT_OK(WriteLandmarkDataset(path, labels, landmarks));
+
+  auto dataset = LandmarkDataset::Open(path);
+  MP_ASSERT_OK(dataset.status());
+  const LandmarkDataset& d = *dataset.ValueOrDie();
+  ASSERT_EQ(d.num_samples(), kNumSamples);
+  for (int i = 0; i < kNumSamples; ++i) {
+    EXPECT_EQ(d.label(i), labels[i]);
+    EXPECT_EQ(std::memcmp(d.landmarks(i),
+                          &landmarks[i * kLandmarkDatasetRowSize],
+                          kLandmarkDatasetRowSize * sizeof(float)),
+              0)
+        << "sample " << i;
+  }
+
+  HandLandmarksSoA hand;
+  d.GetHand(3, &hand);
+  const float* row = &landmarks[3 * kLandmarkDatasetRowSize];
+  for (int i = 0; i < kNumHandLandmarks; ++i) {
+    EXPECT_EQ(hand.x[i], row[3 * i]);
+    EXPECT_EQ(hand.y[i], row[3 * i + 1]);
+    EXPECT_EQ(hand.z[i], row[3 * i + 2]);
+  }
+  for (int i = kNumHandLandmarks; i < kPaddedHandLandmarks; ++i) {
+    EXPECT_EQ(hand.x[i], 0.f);
+  }
+}
+
+TEST(LandmarkDatasetTest, WriteNeedsARowPerLabel) {
+  std::vector<float> landmarks = TestLandmarks();
+  landmarks.pop_back();
+  EXPECT_FALSE(
+      WriteLandmarkDataset(TempPath("short.hgds"), TestLabels(), landmarks)
+          .ok());
+}
+
+TEST(LandmarkDatasetTest, RejectsTruncatedFiles) {
+  const std::string file = TestFile();
+  // Without the last coordinate, within the header, and empty.
+  for (size_t size : {file.size() - 1, sizeof(LandmarkDatasetHeader) - 1,
+                      size_t{0}}) {
+    EXPECT_FALSE(
+        LandmarkDataset::Open(WriteFile("truncated.hgds", file.substr(0, size)))
+            .ok())
+        << size << " bytes";
+  }
+}
+
+TEST(LandmarkDatasetTest, RejectsSampleCountsThatDoNotFit) {
+  std::string file = TestFile();
+  auto* header = reinterpret_cast<LandmarkDatasetHeader*>(&file[0]);
+  header->num_samples = kNumSamples + 1;
+  EXPECT_FALSE(LandmarkDataset::Open(WriteFile("more.hgds", file)).ok());
+  // Samples take 256 bytes, so 2^56 more overflow to the size of the ones
+  // that are there.
+  static_assert(sizeof(int32_t) + kLandmarkDatasetRowSize * sizeof(float) ==
+                    256,
+                "Unexpected sample size.");
+  header->num_samples = kNumSamples + (uint64_t{1} << 56);
+  EXPECT_FALSE(LandmarkDataset::Open(WriteFile("overflow.hgds", file)).ok());
+}
+
+TEST(LandmarkDatasetTest, RejectsBadMagicAndVersion) {
+  std::string file = TestFile();
+  file[0] = 'X';
+  EXPECT_FALSE(LandmarkDataset::Open(WriteFile("magic.hgds", file)).ok());
+
+  file = TestFile();
+  reinterpret_cast<LandmarkDatasetHeader*>(&file[0])->version =
+      kLandmarkDatasetVersion + 1;
+  EXPECT_FALSE(LandmarkDataset::Open(WriteFile("version.hgds", file)).ok());
+}
+
+TEST(LandmarkDatasetTest, RejectsMissingFiles) {
+  EXPECT_FALSE(LandmarkDataset::Open(TempPath("missing.hgds")).ok());
+}
+
+}  // namespace
+}  // namespace mediapipe
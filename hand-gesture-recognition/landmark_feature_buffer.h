@@ -0,0 +1,99 @@
+#ifndef HAND_GESTURE_RECOGNITION_LANDMARK_FEATURE_BUFFER_H_
+#define HAND_GESTURE_RECOGNITION_LANDMARK_FEATURE_BUFFER_H_
+
+#include <algorithm>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "absl/memory/memory.h"
+#include "absl/synchronization/mutex.h"
+
+namespace mediapipe {
+
+// Z-scored landmark features of every hand in a frame, stored back to back in
+// one flat float array. Hand `i` occupies
+// [i * kFeatureSize, (i + 1) * kFeatureSize) as interleaved x, y pairs, the
+// same layout the letter classifier reads.
+//
+// The backing store is shared with the LandmarkFeatureBufferPool that
+// produced it and goes back to the pool once the last packet holding it is
+// released.
+class LandmarkFeatureBuffer {
+ public:
+  static constexpr int kFeatureSize = 42;
+
+  LandmarkFeatureBuffer() = default;
+  LandmarkFeatureBuffer(std::shared_ptr<std::vector<float>> storage,
+                        int num_hands)
+      : storage_(std::move(storage)), num_hands_(num_hands) {}
+
+  int num_hands() const { return num_hands_; }
+  const float* data() const { return storage_ ? storage_->data() : nullptr; }
+  const float* hand(int i) const { return data() + i * kFeatureSize; }
+
+ private:
+  std::shared_ptr<std::vector<float>> storage_;
+  int num_hands_ = 0;
+};
+
+// Hands out feature storage that is no longer referenced by any packet, so a
+// calculator can emit a fresh LandmarkFeatureBuffer per frame without
+// allocating once the pool has warmed up.
+//
+// Storage comes back through the deleter of the shared_ptr returned by
+// Acquire(), which may run on any graph thread when the last packet holding
+// it is released. The free list is guarded by a mutex, so the writes of the
+// next Acquire() happen after every read of the previous owner. Storage
+// released after the pool is gone is simply freed.
+//
+// Acquire() is meant to be called by a single calculator from Process().
+class LandmarkFeatureBufferPool {
+ public:
+  explicit LandmarkFeatureBufferPool(int max_num_hands)
+      : capacity_(max_num_hands * LandmarkFeatureBuffer::kFeatureSize),
+        free_list_(std::make_shared<FreeList>()) {}
+
+  // Returns storage resized to `num_hands` hands. It goes back to the pool
+  // once the last reference to it is dropped.
+  std::shared_ptr<std::vector<float>> Acquire(int num_hands) {
+    const int size = num_hands * LandmarkFeatureBuffer::kFeatureSize;
+    std::unique_ptr<std::vector<float>> storage;
+    {
+      absl::MutexLock lock(&free_list_->mutex);
+      if (!free_list_->storage.empty()) {
+        storage = std::move(free_list_->storage.back());
+        free_list_->storage.pop_back();
+      }
+    }
+    if (!storage) {
+      storage = absl::make_unique<std::vector<float>>();
+      storage->reserve(std::max(size, capacity_));
+    }
+    storage->resize(size);
+    std::weak_ptr<FreeList> free_list = free_list_;
+    return std::shared_ptr<std::vector<float>>(
+        storage.release(), [free_list](std::vector<float>* released) {
+          std::unique_ptr<std::vector<float>> owned(released);
+          if (auto list = free_list.lock()) {
+            absl::MutexLock lock(&list->mutex);
+            list->storage.push_back(std::move(owned));
+          }
+        });
+  }
+
+ private:
+  struct FreeList {
+    absl::Mutex mutex;
+    std::vector<std::unique_ptr<std::vector<float>>> storage
+        ABSL_GUARDED_BY(mutex);
+  };
+
+  int capacity_;
+  // Shared with the deleters of the storage in flight.
+  std::shared_ptr<FreeList> free_list_;
+};
+
+}  // namespace mediapipe
+
+#endif  // HAND_GESTURE_RECOGNITION_LANDMARK_FEATURE_BUFFER_H_
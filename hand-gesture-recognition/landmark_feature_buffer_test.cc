@@ -0,0 +1,61 @@
+#include "hand-gesture-recognition/landmark_feature_buffer.h"
+
+#include <algorithm>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "mediapipe/framework/port/gtest.h"
+
+namespace mediapipe {
+namespace {
+
+TEST(LandmarkFeatureBufferPoolTest, ReusesReleasedStorage) {
+  LandmarkFeatureBufferPool pool(2);
+  auto first = pool.Acquire(2);
+  EXPECT_EQ(first->size(), 2u * LandmarkFeatureBuffer::kFeatureSize);
+  const float* data = first->data();
+  LandmarkFeatureBuffer buffer(first, 2);
+  first.reset();
+
+  // Still held by `buffer`.
+  auto second = pool.Acquire(1);
+  EXPECT_NE(second->data(), data);
+  EXPECT_EQ(second->size(), 1u * LandmarkFeatureBuffer::kFeatureSize);
+
+  buffer = LandmarkFeatureBuffer();
+  auto third = pool.Acquire(1);
+  EXPECT_EQ(third->data(), data);
+}
+
+TEST(LandmarkFeatureBufferPoolTest, StorageMayOutliveThePool) {
+  std::shared_ptr<std::vector<float>> storage;
+  {
+    LandmarkFeatureBufferPool pool(1);
+    storage = pool.Acquire(1);
+  }
+  (*storage)[0] = 1.f;
+  storage.reset();
+}
+
+// Readers on other threads release buffers while the writer reuses them; a
+// missing handoff shows up under TSAN or as a changed value below.
+TEST(LandmarkFeatureBufferPoolTest, ReleaseOnAnotherThread) {
+  constexpr int kNumFrames = 2000;
+  LandmarkFeatureBufferPool pool(1);
+  std::vector<std::thread> readers;
+  for (int frame = 0; frame < kNumFrames; ++frame) {
+    auto storage = pool.Acquire(1);
+    std::fill(storage->begin(), storage->end(), static_cast<float>(frame));
+    LandmarkFeatureBuffer buffer(std::move(storage), 1);
+    readers.emplace_back([buffer, frame] {
+      for (int i = 0; i < LandmarkFeatureBuffer::kFeatureSize; ++i) {
+        ASSERT_EQ(buffer.hand(0)[i], static_cast<float>(frame));
+      }
+    });
+  }
+  for (std::thread& reader : readers) reader.join();
+}
+
+}  // namespace
+}  // namespace mediapipe
@@ -0,0 +1,543 @@
+#include "hand-gesture-recognition/landmark_features.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define HAND_GESTURE_FEATURES_AVX2 1
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define HAND_GESTURE_FEATURES_SSE2 1
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define HAND_GESTURE_FEATURES_NEON 1
+#endif
+
+namespace mediapipe {
+
+namespace {
+
+// 1 for real landmarks, 0 for padding lanes.
+alignas(32) constexpr float kLaneMask[kPaddedHandLandmarks] = {
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 0, 0, 0};
+
+// Linear map from wrist-relative landmarks to the canonical hand frame:
+// x' = xx * dx + xy * dy, y' = yx * dx + yy * dy, z' = zz * dz.
+struct CanonicalFrame {
+  float xx, xy;
+  float yx, yy;
+  float zz;
+};
+
+// Undoes `rotation` about the wrist, with x and z first scaled to image
+// heights, and mirrors the hand when the index finger base (5) would end up
+// right of the pinky base (17). With `unit_palm`, the wrist to middle finger
+// base (9) distance also becomes 1.
+CanonicalFrame MakeCanonicalFrame(const HandLandmarksSoA& hand, float rotation,
+                                  float aspect_ratio, bool unit_palm) {
+  const float c = std::cos(rotation);
+  const float s = std::sin(rotation);
+  CanonicalFrame frame{c * aspect_ratio, s, -s * aspect_ratio, c,
+                       aspect_ratio};
+  const float dx = hand.x[5] - hand.x[17];
+  const float dy = hand.y[5] - hand.y[17];
+  if (frame.xx * dx + frame.xy * dy > 0.f) {
+    frame.xx = -frame.xx;
+    frame.xy = -frame.xy;
+  }
+  if (unit_palm) {
+    const float px = aspect_ratio * (hand.x[9] - hand.x[0]);
+    const float py = hand.y[9] - hand.y[0];
+    const float pz = aspect_ratio * (hand.z[9] - hand.z[0]);
+    const float palm = std::sqrt(px * px + py * py + pz * pz);
+    if (palm > 0.f) {
+      const float scale = 1.f / palm;
+      frame.xx *= scale;
+      frame.xy *= scale;
+      frame.yx *= scale;
+      frame.yy *= scale;
+      frame.zz *= scale;
+    }
+  }
+  return frame;
+}
+
+// Each kernel set below provides the same five primitives over the
+// kPaddedHandLandmarks lanes of a HandLandmarksSoA row:
+//   SumLanes, SumSquaredDeviation (padding masked out), Normalize,
+//   DistancesFrom and TransformLanes (padding masked out), plus
+//   InterleaveLandmarks for the 42-float output.
+
+#if defined(HAND_GESTURE_FEATURES_AVX2) || defined(HAND_GESTURE_FEATURES_SSE2)
+
+inline float HorizontalSum(__m128 v) {
+  __m128 shuffled = _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1));
+  __m128 sums = _mm_add_ps(v, shuffled);
+  shuffled = _mm_movehl_ps(shuffled, sums);
+  sums = _mm_add_ss(sums, shuffled);
+  return _mm_cvtss_f32(sums);
+}
+
+// Both x86 kernel sets interleave with SSE, AVX2 lane-crossing unpacks would
+// not be any faster for 21 landmarks.
+inline void InterleaveLandmarks(const float* a, const float* b, float* out) {
+  int i = 0;
+  for (; i + 4 <= kNumHandLandmarks; i += 4) {
+    const __m128 va = _mm_loadu_ps(a + i);
+    const __m128 vb = _mm_loadu_ps(b + i);
+    _mm_storeu_ps(out + 2 * i, _mm_unpacklo_ps(va, vb));
+    _mm_storeu_ps(out + 2 * i + 4, _mm_unpackhi_ps(va, vb));
+  }
+  for (; i < kNumHandLandmarks; ++i) {
+    out[2 * i] = a[i];
+    out[2 * i + 1] = b[i];
+  }
+}
+
+#endif
+
+#if defined(HAND_GESTURE_FEATURES_AVX2)
+
+inline float HorizontalSum(__m256 v) {
+  return HorizontalSum(
+      _mm_add_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1)));
+}
+
+inline float SumLanes(const float* v) {
+  __m256 sum = _mm256_loadu_ps(v);
+  sum = _mm256_add_ps(sum, _mm256_loadu_ps(v + 8));
+  sum = _mm256_add_ps(sum, _mm256_loadu_ps(v + 16));
+  return HorizontalSum(sum);
+}
+
+inline float SumSquaredDeviation(const float* v, float mean) {
+  const __m256 vmean = _mm256_set1_ps(mean);
+  __m256 sum = _mm256_setzero_ps();
+  for (int i = 0; i < kPaddedHandLandmarks; i += 8) {
+    const __m256 d = _mm256_mul_ps(_mm256_sub_ps(_mm256_loadu_ps(v + i), vmean),
+                                   _mm256_loadu_ps(kLaneMask + i));
+    sum = _mm256_add_ps(sum, _mm256_mul_ps(d, d));
+  }
+  return HorizontalSum(sum);
+}
+
+inline void Normalize(const float* v, float mean, float scale, float* out) {
+  const __m256 vmean = _mm256_set1_ps(mean);
+  const __m256 vscale = _mm256_set1_ps(scale);
+  for (int i = 0; i < kPaddedHandLandmarks; i += 8) {
+    _mm256_store_ps(out + i, _mm256_div_ps(
+                                 _mm256_sub_ps(_mm256_loadu_ps(v + i), vmean),
+                                 vscale));
+  }
+}
+
+inline void DistancesFrom(const HandLandmarksSoA& hand, int i, float* out) {
+  const __m256 xi = _mm256_set1_ps(hand.x[i]);
+  const __m256 yi = _mm256_set1_ps(hand.y[i]);
+  for (int j = 0; j < kPaddedHandLandmarks; j += 8) {
+    const __m256 dx = _mm256_sub_ps(_mm256_loadu_ps(hand.x + j), xi);
+    const __m256 dy = _mm256_sub_ps(_mm256_loadu_ps(hand.y + j), yi);
+    const __m256 d2 = _mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy));
+    _mm256_store_ps(out + j, _mm256_sqrt_ps(d2));
+  }
+}
+
+inline void TransformLanes(const HandLandmarksSoA& hand,
+                           const CanonicalFrame& frame, HandLandmarksSoA* out) {
+  const __m256 x0 = _mm256_set1_ps(hand.x[0]);
+  const __m256 y0 = _mm256_set1_ps(hand.y[0]);
+  const __m256 z0 = _mm256_set1_ps(hand.z[0]);
+  const __m256 xx = _mm256_set1_ps(frame.xx);
+  const __m256 xy = _mm256_set1_ps(frame.xy);
+  const __m256 yx = _mm256_set1_ps(frame.yx);
+  const __m256 yy = _mm256_set1_ps(frame.yy);
+  const __m256 zz = _mm256_set1_ps(frame.zz);
+  for (int i = 0; i < kPaddedHandLandmarks; i += 8) {
+    const __m256 mask = _mm256_loadu_ps(kLaneMask + i);
+    const __m256 dx =
+        _mm256_mul_ps(_mm256_sub_ps(_mm256_loadu_ps(hand.x + i), x0), mask);
+    const __m256 dy =
+        _mm256_mul_ps(_mm256_sub_ps(_mm256_loadu_ps(hand.y + i), y0), mask);
+    const __m256 dz =
+        _mm256_mul_ps(_mm256_sub_ps(_mm256_loadu_ps(hand.z + i), z0), mask);
+    _mm256_storeu_ps(out->x + i, _mm256_add_ps(_mm256_mul_ps(xx, dx),
+                                               _mm256_mul_ps(xy, dy)));
+    _mm256_storeu_ps(out->y + i, _mm256_add_ps(_mm256_mul_ps(yx, dx),
+                                               _mm256_mul_ps(yy, dy)));
+    _mm256_storeu_ps(out->z + i, _mm256_mul_ps(zz, dz));
+  }
+}
+
+#elif defined(HAND_GESTURE_FEATURES_SSE2)
+
+inline float SumLanes(const float* v) {
+  __m128 sum = _mm_loadu_ps(v);
+  for (int i = 4; i < kPaddedHandLandmarks; i += 4) {
+    sum = _mm_add_ps(sum, _mm_loadu_ps(v + i));
+  }
+  return HorizontalSum(sum);
+}
+
+inline float SumSquaredDeviation(const float* v, float mean) {
+  const __m128 vmean = _mm_set1_ps(mean);
+  __m128 sum = _mm_setzero_ps();
+  for (int i = 0; i < kPaddedHandLandmarks; i += 4) {
+    const __m128 d = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(v + i), vmean),
+                                _mm_loadu_ps(kLaneMask + i));
+    sum = _mm_add_ps(sum, _mm_mul_ps(d, d));
+  }
+  return HorizontalSum(sum);
+}
+
+inline void Normalize(const float* v, float mean, float scale, float* out) {
+  const __m128 vmean = _mm_set1_ps(mean);
+  const __m128 vscale = _mm_set1_ps(scale);
+  for (int i = 0; i < kPaddedHandLandmarks; i += 4) {
+    _mm_store_ps(out + i,
+                 _mm_div_ps(_mm_sub_ps(_mm_loadu_ps(v + i), vmean), vscale));
+  }
+}
+
+inline void DistancesFrom(const HandLandmarksSoA& hand, int i, float* out) {
+  const __m128 xi = _mm_set1_ps(hand.x[i]);
+  const __m128 yi = _mm_set1_ps(hand.y[i]);
+  for (int j = 0; j < kPaddedHandLandmarks; j += 4) {
+    const __m128 dx = _mm_sub_ps(_mm_loadu_ps(hand.x + j), xi);
+    const __m128 dy = _mm_sub_ps(_mm_loadu_ps(hand.y + j), yi);
+    const __m128 d2 = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+    _mm_store_ps(out + j, _mm_sqrt_ps(d2));
+  }
+}
+
+inline void TransformLanes(const HandLandmarksSoA& hand,
+                           const CanonicalFrame& frame, HandLandmarksSoA* out) {
+  const __m128 x0 = _mm_set1_ps(hand.x[0]);
+  const __m128 y0 = _mm_set1_ps(hand.y[0]);
+  const __m128 z0 = _mm_set1_ps(hand.z[0]);
+  const __m128 xx = _mm_set1_ps(frame.xx);
+  const __m128 xy = _mm_set1_ps(frame.xy);
+  const __m128 yx = _mm_set1_ps(frame.yx);
+  const __m128 yy = _mm_set1_ps(frame.yy);
+  const __m128 zz = _mm_set1_ps(frame.zz);
+  for (int i = 0; i < kPaddedHandLandmarks; i += 4) {
+    const __m128 mask = _mm_loadu_ps(kLaneMask + i);
+    const __m128 dx =
+        _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(hand.x + i), x0), mask);
+    const __m128 dy =
+        _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(hand.y + i), y0), mask);
+    const __m128 dz =
+        _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(hand.z + i), z0), mask);
+    _mm_storeu_ps(out->x + i,
+                  _mm_add_ps(_mm_mul_ps(xx, dx), _mm_mul_ps(xy, dy)));
+    _mm_storeu_ps(out->y + i,
+                  _mm_add_ps(_mm_mul_ps(yx, dx), _mm_mul_ps(yy, dy)));
+    _mm_storeu_ps(out->z + i, _mm_mul_ps(zz, dz));
+  }
+}
+
+#elif defined(HAND_GESTURE_FEATURES_NEON)
+
+inline float HorizontalSum(float32x4_t v) {
+#if defined(__aarch64__)
+  return vaddvq_f32(v);
+#else
+  const float32x2_t sum = vadd_f32(vget_low_f32(v), vget_high_f32(v));
+  return vget_lane_f32(vpadd_f32(sum, sum), 0);
+#endif
+}
+
+// vdivq_f32 and vsqrtq_f32 only exist on AArch64. 32-bit ARM refines the
+// reciprocal estimates with two Newton-Raphson steps instead.
+inline float32x4_t Divide(float32x4_t a, float32x4_t b) {
+#if defined(__aarch64__)
+  return vdivq_f32(a, b);
+#else
+  float32x4_t reciprocal = vrecpeq_f32(b);
+  reciprocal = vmulq_f32(vrecpsq_f32(b, reciprocal), reciprocal);
+  reciprocal = vmulq_f32(vrecpsq_f32(b, reciprocal), reciprocal);
+  return vmulq_f32(a, reciprocal);
+#endif
+}
+
+inline float32x4_t SquareRoot(float32x4_t v) {
+#if defined(__aarch64__)
+  return vsqrtq_f32(v);
+#else
+  // sqrt(v) = v * rsqrt(v), with rsqrt(0) masked so that sqrt(0) stays 0.
+  float32x4_t rsqrt = vrsqrteq_f32(v);
+  rsqrt = vmulq_f32(vrsqrtsq_f32(vmulq_f32(v, rsqrt), rsqrt), rsqrt);
+  rsqrt = vmulq_f32(vrsqrtsq_f32(vmulq_f32(v, rsqrt), rsqrt), rsqrt);
+  const uint32x4_t is_zero = vceqq_f32(v, vdupq_n_f32(0.f));
+  return vbslq_f32(is_zero, v, vmulq_f32(v, rsqrt));
+#endif
+}
+
+inline float SumLanes(const float* v) {
+  float32x4_t sum = vld1q_f32(v);
+  for (int i = 4; i < kPaddedHandLandmarks; i += 4) {
+    sum = vaddq_f32(sum, vld1q_f32(v + i));
+  }
+  return HorizontalSum(sum);
+}
+
+inline float SumSquaredDeviation(const float* v, float mean) {
+  const float32x4_t vmean = vdupq_n_f32(mean);
+  float32x4_t sum = vdupq_n_f32(0.f);
+  for (int i = 0; i < kPaddedHandLandmarks; i += 4) {
+    const float32x4_t d =
+        vmulq_f32(vsubq_f32(vld1q_f32(v + i), vmean), vld1q_f32(kLaneMask + i));
+    sum = vmlaq_f32(sum, d, d);
+  }
+  return HorizontalSum(sum);
+}
+
+inline void Normalize(const float* v, float mean, float scale, float* out) {
+  const float32x4_t vmean = vdupq_n_f32(mean);
+  const float32x4_t vscale = vdupq_n_f32(scale);
+  for (int i = 0; i < kPaddedHandLandmarks; i += 4) {
+    vst1q_f32(out + i, Divide(vsubq_f32(vld1q_f32(v + i), vmean), vscale));
+  }
+}
+
+inline void DistancesFrom(const HandLandmarksSoA& hand, int i, float* out) {
+  const float32x4_t xi = vdupq_n_f32(hand.x[i]);
+  const float32x4_t yi = vdupq_n_f32(hand.y[i]);
+  for (int j = 0; j < kPaddedHandLandmarks; j += 4) {
+    const float32x4_t dx = vsubq_f32(vld1q_f32(hand.x + j), xi);
+    const float32x4_t dy = vsubq_f32(vld1q_f32(hand.y + j), yi);
+    vst1q_f32(out + j, SquareRoot(vmlaq_f32(vmulq_f32(dx, dx), dy, dy)));
+  }
+}
+
+inline void TransformLanes(const HandLandmarksSoA& hand,
+                           const CanonicalFrame& frame, HandLandmarksSoA* out) {
+  const float32x4_t x0 = vdupq_n_f32(hand.x[0]);
+  const float32x4_t y0 = vdupq_n_f32(hand.y[0]);
+  const float32x4_t z0 = vdupq_n_f32(hand.z[0]);
+  const float32x4_t xx = vdupq_n_f32(frame.xx);
+  const float32x4_t xy = vdupq_n_f32(frame.xy);
+  const float32x4_t yx = vdupq_n_f32(frame.yx);
+  const float32x4_t yy = vdupq_n_f32(frame.yy);
+  const float32x4_t zz = vdupq_n_f32(frame.zz);
+  for (int i = 0; i < kPaddedHandLandmarks; i += 4) {
+    const float32x4_t mask = vld1q_f32(kLaneMask + i);
+    const float32x4_t dx =
+        vmulq_f32(vsubq_f32(vld1q_f32(hand.x + i), x0), mask);
+    const float32x4_t dy =
+        vmulq_f32(vsubq_f32(vld1q_f32(hand.y + i), y0), mask);
+    const float32x4_t dz =
+        vmulq_f32(vsubq_f32(vld1q_f32(hand.z + i), z0), mask);
+    vst1q_f32(out->x + i, vmlaq_f32(vmulq_f32(xx, dx), xy, dy));
+    vst1q_f32(out->y + i, vmlaq_f32(vmulq_f32(yx, dx), yy, dy));
+    vst1q_f32(out->z + i, vmulq_f32(zz, dz));
+  }
+}
+
+inline void InterleaveLandmarks(const float* a, const float* b, float* out) {
+  int i = 0;
+  for (; i + 4 <= kNumHandLandmarks; i += 4) {
+    float32x4x2_t pair;
+    pair.val[0] = vld1q_f32(a + i);
+    pair.val[1] = vld1q_f32(b + i);
+    vst2q_f32(out + 2 * i, pair);
+  }
+  for (; i < kNumHandLandmarks; ++i) {
+    out[2 * i] = a[i];
+    out[2 * i + 1] = b[i];
+  }
+}
+
+#else
+
+inline float SumLanes(const float* v) {
+  float sum = 0.f;
+  for (int i = 0; i < kNumHandLandmarks; ++i) sum += v[i];
+  return sum;
+}
+
+inline float SumSquaredDeviation(const float* v, float mean) {
+  float sum = 0.f;
+  for (int i = 0; i < kNumHandLandmarks; ++i) {
+    const float d = v[i] - mean;
+    sum += d * d;
+  }
+  return sum;
+}
+
+inline void Normalize(const float* v, float mean, float scale, float* out) {
+  for (int i = 0; i < kNumHandLandmarks; ++i) out[i] = (v[i] - mean) / scale;
+}
+
+inline void DistancesFrom(const HandLandmarksSoA& hand, int i, float* out) {
+  for (int j = 0; j < kNumHandLandmarks; ++j) {
+    const float dx = hand.x[j] - hand.x[i];
+    const float dy = hand.y[j] - hand.y[i];
+    out[j] = std::sqrt(dx * dx + dy * dy);
+  }
+}
+
+inline void TransformLanes(const HandLandmarksSoA& hand,
+                           const CanonicalFrame& frame, HandLandmarksSoA* out) {
+  const float x0 = hand.x[0];
+  const float y0 = hand.y[0];
+  const float z0 = hand.z[0];
+  for (int i = 0; i < kNumHandLandmarks; ++i) {
+    const float dx = hand.x[i] - x0;
+    const float dy = hand.y[i] - y0;
+    out->x[i] = frame.xx * dx + frame.xy * dy;
+    out->y[i] = frame.yx * dx + frame.yy * dy;
+    out->z[i] = frame.zz * (hand.z[i] - z0);
+  }
+  for (int i = kNumHandLandmarks; i < kPaddedHandLandmarks; ++i) {
+    out->x[i] = 0.f;
+    out->y[i] = 0.f;
+    out->z[i] = 0.f;
+  }
+}
+
+inline void InterleaveLandmarks(const float* a, const float* b, float* out) {
+  for (int i = 0; i < kNumHandLandmarks; ++i) {
+    out[2 * i] = a[i];
+    out[2 * i + 1] = b[i];
+  }
+}
+
+#endif
+
+}  // namespace
+
+void ComputeZScoreFeatures(const HandLandmarksSoA& hand, float* out) {
+  const float x_mean = SumLanes(hand.x) / kNumHandLandmarks;
+  const float y_mean = SumLanes(hand.y) / kNumHandLandmarks;
+  const float x_sdev = std::sqrt(SumSquaredDeviation(hand.x, x_mean));
+  const float y_sdev = std::sqrt(SumSquaredDeviation(hand.y, y_mean));
+
+  alignas(32) float x_scores[kPaddedHandLandmarks];
+  alignas(32) float y_scores[kPaddedHandLandmarks];
+  Normalize(hand.x, x_mean, x_sdev, x_scores);
+  Normalize(hand.y, y_mean, y_sdev, y_scores);
+  InterleaveLandmarks(x_scores, y_scores, out);
+}
+
+void ComputePairwiseDistanceFeatures(const HandLandmarksSoA& hand,
+                                     float* out) {
+  alignas(32) float row[kPaddedHandLandmarks];
+  for (int i = 0; i < kNumHandLandmarks - 1; ++i) {
+    DistancesFrom(hand, i, row);
+    const int count = kNumHandLandmarks - 1 - i;
+    std::memcpy(out, row + i + 1, count * sizeof(float));
+    out += count;
+  }
+}
+
+void CanonicalizeHand(const HandLandmarksSoA& hand, float rotation,
+                      float aspect_ratio, HandLandmarksSoA* canonical) {
+  TransformLanes(hand,
+                 MakeCanonicalFrame(hand, rotation, aspect_ratio,
+                                    /*unit_palm=*/false),
+                 canonical);
+}
+
+void ComputeInvariantFeatures(const HandLandmarksSoA& hand, float rotation,
+                              float aspect_ratio, float* out) {
+  HandLandmarksSoA canonical;
+  TransformLanes(hand,
+                 MakeCanonicalFrame(hand, rotation, aspect_ratio,
+                                    /*unit_palm=*/true),
+                 &canonical);
+  // The wrist is the origin, only the other landmarks carry information.
+  constexpr int kCount = kNumHandLandmarks - 1;
+  std::memcpy(out, canonical.x + 1, kCount * sizeof(float));
+  std::memcpy(out + kCount, canonical.y + 1, kCount * sizeof(float));
+  std::memcpy(out + 2 * kCount, canonical.z + 1, kCount * sizeof(float));
+}
+
+float HandRotationFromLandmarks(const HandLandmarksSoA& hand,
+                                float aspect_ratio) {
+  constexpr float kPi = 3.14159265358979f;
+  const float angle = std::atan2(-(hand.y[9] - hand.y[0]),
+                                 aspect_ratio * (hand.x[9] - hand.x[0]));
+  // Normalized to [-pi, pi), like the rects of the hand tracking graphs.
+  const float rotation = kPi / 2 - angle;
+  return rotation - 2 * kPi * std::floor((rotation + kPi) / (2 * kPi));
+}
+
+float MaxLandmarkDisplacement(const HandLandmarksSoA& a,
+                              const HandLandmarksSoA& b) {
+  // Padding lanes are zero in both inputs, so the full width is safe to scan
+  // and the loop stays trivially vectorizable.
+  float max_squared = 0.f;
+  for (int i = 0; i < kPaddedHandLandmarks; ++i) {
+    const float dx = a.x[i] - b.x[i];
+    const float dy = a.y[i] - b.y[i];
+    max_squared = std::max(max_squared, dx * dx + dy * dy);
+  }
+  return std::sqrt(max_squared);
+}
+
+void ComputeZScoreFeaturesScalar(const HandLandmarksSoA& hand, float* out) {
+  float x_mean = 0.f;
+  float y_mean = 0.f;
+  for (int i = 0; i < kNumHandLandmarks; ++i) {
+    x_mean += hand.x[i];
+    y_mean += hand.y[i];
+  }
+  x_mean /= kNumHandLandmarks;
+  y_mean /= kNumHandLandmarks;
+
+  float x_sdev = 0.f;
+  float y_sdev = 0.f;
+  for (int i = 0; i < kNumHandLandmarks; ++i) {
+    x_sdev += (hand.x[i] - x_mean) * (hand.x[i] - x_mean);
+    y_sdev += (hand.y[i] - y_mean) * (hand.y[i] - y_mean);
+  }
+  x_sdev = std::sqrt(x_sdev);
+  y_sdev = std::sqrt(y_sdev);
+
+  for (int i = 0; i < kNumHandLandmarks; ++i) {
+    out[2 * i] = (hand.x[i] - x_mean) / x_sdev;
+    out[2 * i + 1] = (hand.y[i] - y_mean) / y_sdev;
+  }
+}
+
+void ComputePairwiseDistanceFeaturesScalar(const HandLandmarksSoA& hand,
+                                           float* out) {
+  for (int i = 0; i < kNumHandLandmarks; ++i) {
+    for (int j = i + 1; j < kNumHandLandmarks; ++j) {
+      const float dx = hand.x[j] - hand.x[i];
+      const float dy = hand.y[j] - hand.y[i];
+      *out++ = std::sqrt(dx * dx + dy * dy);
+    }
+  }
+}
+
+void ComputeInvariantFeaturesScalar(const HandLandmarksSoA& hand,
+                                    float rotation, float aspect_ratio,
+                                    float* out) {
+  const CanonicalFrame frame =
+      MakeCanonicalFrame(hand, rotation, aspect_ratio, /*unit_palm=*/true);
+  constexpr int kCount = kNumHandLandmarks - 1;
+  for (int i = 1; i < kNumHandLandmarks; ++i) {
+    const float dx = hand.x[i] - hand.x[0];
+    const float dy = hand.y[i] - hand.y[0];
+    out[i - 1] = frame.xx * dx + frame.xy * dy;
+    out[kCount + i - 1] = frame.yx * dx + frame.yy * dy;
+    out[2 * kCount + i - 1] = frame.zz * (hand.z[i] - hand.z[0]);
+  }
+}
+
+const char* LandmarkFeatureKernelName() {
+#if defined(HAND_GESTURE_FEATURES_AVX2)
+  return "avx2";
+#elif defined(HAND_GESTURE_FEATURES_SSE2)
+  return "sse2";
+#elif defined(HAND_GESTURE_FEATURES_NEON)
+  return "neon";
+#else
+  return "scalar";
+#endif
+}
+
+}  // namespace mediapipe
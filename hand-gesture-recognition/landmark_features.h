@@ -0,0 +1,101 @@
+#ifndef HAND_GESTURE_RECOGNITION_LANDMARK_FEATURES_H_
+#define HAND_GESTURE_RECOGNITION_LANDMARK_FEATURES_H_
+
+namespace mediapipe {
+
+constexpr int kNumHandLandmarks = 21;
+// Landmarks are padded to a multiple of the widest vector (8 floats for
+// AVX2). Padding lanes are kept at zero and never reach the outputs.
+constexpr int kPaddedHandLandmarks = 24;
+
+// Interleaved x, y z-scores of the 21 landmarks.
+constexpr int kZScoreFeatureSize = 2 * kNumHandLandmarks;
+// Euclidean x/y distance of every landmark pair (i < j), row by row.
+constexpr int kPairwiseDistanceFeatureSize =
+    kNumHandLandmarks * (kNumHandLandmarks - 1) / 2;
+// Canonical x, y and z of the 20 landmarks besides the wrist, see
+// ComputeInvariantFeatures.
+constexpr int kInvariantFeatureSize = 3 * (kNumHandLandmarks - 1);
+
+// Landmarks of one hand in structure-of-arrays form. The kernels use
+// unaligned loads, so instances may live in heap-allocated calculators or
+// containers without over-aligned allocation support.
+struct alignas(32) HandLandmarksSoA {
+  float x[kPaddedHandLandmarks];
+  float y[kPaddedHandLandmarks];
+  float z[kPaddedHandLandmarks];
+};
+
+// Fills `soa` from any container of landmarks exposing x(), y() and z(), e.g.
+// NormalizedLandmarkList::landmark() or std::vector<NormalizedLandmark>. Only
+// the first kNumHandLandmarks entries are read.
+template <typename Landmarks>
+void ToHandLandmarksSoA(const Landmarks& landmarks, HandLandmarksSoA* soa) {
+  int i = 0;
+  for (const auto& landmark : landmarks) {
+    if (i == kNumHandLandmarks) break;
+    soa->x[i] = landmark.x();
+    soa->y[i] = landmark.y();
+    soa->z[i] = landmark.z();
+    ++i;
+  }
+  for (; i < kPaddedHandLandmarks; ++i) {
+    soa->x[i] = 0.f;
+    soa->y[i] = 0.f;
+    soa->z[i] = 0.f;
+  }
+}
+
+// Writes the kZScoreFeatureSize inputs of the letter classifier to `out`:
+// (v - mean) / sqrt(sum((v - mean)^2)) for x and y, interleaved per landmark.
+// The scale is deliberately not divided by the landmark count, the model was
+// trained that way. `out` may point straight into an interpreter tensor.
+void ComputeZScoreFeatures(const HandLandmarksSoA& hand, float* out);
+
+// Writes the kPairwiseDistanceFeatureSize x/y distances to `out`.
+void ComputePairwiseDistanceFeatures(const HandLandmarksSoA& hand, float* out);
+
+// Maps a hand into its canonical frame: wrist at the origin, fingers
+// pointing up (towards -y, as in the image), index finger on the left of the
+// pinky, and x, y, z in image heights. Undoes the hand rect `rotation`
+// (NormalizedRect::rotation, radians) and mirrors left hands onto right
+// ones, so that finger tests written for an upright right hand hold for any
+// hand. `aspect_ratio` is the image width over its height; normalized x and
+// z are in image widths. Padding lanes stay zero.
+void CanonicalizeHand(const HandLandmarksSoA& hand, float rotation,
+                      float aspect_ratio, HandLandmarksSoA* canonical);
+
+// Writes the kInvariantFeatureSize features of a hand to `out`: the
+// canonical coordinates of landmarks 1 to 20, divided by the 3D distance
+// from the wrist to the middle finger base. They are invariant to the
+// position, in-plane rotation, size and handedness of the hand, and stored
+// as all x, then all y, then all z.
+void ComputeInvariantFeatures(const HandLandmarksSoA& hand, float rotation,
+                              float aspect_ratio, float* out);
+
+// Rotation of an upright hand rect for `hand`, in the convention of
+// NormalizedRect::rotation, from the direction of the wrist to the middle
+// finger base. For hands recorded without their rect.
+float HandRotationFromLandmarks(const HandLandmarksSoA& hand,
+                                float aspect_ratio);
+
+// Largest x/y distance any landmark moved between `a` and `b`.
+float MaxLandmarkDisplacement(const HandLandmarksSoA& a,
+                              const HandLandmarksSoA& b);
+
+// Plain scalar versions of the kernels above. The vectorized kernels match
+// them within float rounding; they are kept as the reference.
+void ComputeZScoreFeaturesScalar(const HandLandmarksSoA& hand, float* out);
+void ComputePairwiseDistanceFeaturesScalar(const HandLandmarksSoA& hand,
+                                           float* out);
+void ComputeInvariantFeaturesScalar(const HandLandmarksSoA& hand,
+                                    float rotation, float aspect_ratio,
+                                    float* out);
+
+// Name of the kernel set picked at compile time: "avx2", "sse2", "neon" or
+// "scalar".
+const char* LandmarkFeatureKernelName();
+
+}  // namespace mediapipe
+
+#endif  // HAND_GESTURE_RECOGNITION_LANDMARK_FEATURES_H_
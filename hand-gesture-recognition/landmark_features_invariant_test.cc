@@ -0,0 +1,157 @@
+#include "hand-gesture-recognition/landmark_features.h"
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "mediapipe/framework/port/gtest.h"
+
+namespace mediapipe {
+namespace {
+
+// See landmark_features_test.cc; the invariant features are of order one
+// too.
+constexpr float kTolerance = 1e-5f;
+// Moving a hand around goes through a rotation and back, which loses a few
+// more bits.
+constexpr float kInvarianceTolerance = 1e-4f;
+constexpr float kGuard = -12345.f;
+constexpr int kNumRandomHands = 200;
+// Normalized x and z are in image widths, y in image heights.
+constexpr float kAspectRatio = 16.f / 9.f;
+
+HandLandmarksSoA RandomHand(std::mt19937* rng) {
+  std::uniform_real_distribution<float> coordinate(0.05f, 0.95f);
+  std::uniform_real_distribution<float> depth(-0.2f, 0.2f);
+  HandLandmarksSoA hand = {};
+  for (int i = 0; i < kNumHandLandmarks; ++i) {
+    hand.x[i] = coordinate(*rng);
+    hand.y[i] = coordinate(*rng);
+    hand.z[i] = depth(*rng);
+  }
+  return hand;
+}
+
+// An open right hand, upright, palm to the camera.
+HandLandmarksSoA OpenHand() {
+  // Wrist, then thumb, index, middle, ring and pinky, base to tip, in image
+  // heights relative to the wrist.
+  static const float kPoints[kNumHandLandmarks][3] = {
+      {0.f, 0.f, 0.f},         {-0.06f, -0.04f, -0.01f},
+      {-0.1f, -0.09f, -0.02f}, {-0.13f, -0.13f, -0.03f},
+      {-0.15f, -0.17f, -0.03f}, {-0.05f, -0.2f, -0.01f},
+      {-0.06f, -0.27f, -0.02f}, {-0.065f, -0.32f, -0.02f},
+      {-0.07f, -0.36f, -0.03f}, {0.f, -0.21f, 0.f},
+      {0.f, -0.29f, -0.01f},   {0.f, -0.34f, -0.02f},
+      {0.f, -0.38f, -0.02f},   {0.045f, -0.2f, 0.f},
+      {0.05f, -0.27f, -0.01f}, {0.055f, -0.31f, -0.02f},
+      {0.06f, -0.34f, -0.02f}, {0.085f, -0.17f, 0.01f},
+      {0.1f, -0.22f, 0.f},     {0.11f, -0.25f, -0.01f},
+      {0.12f, -0.28f, -0.01f},
+  };
+  HandLandmarksSoA hand = {};
+  for (int i = 0; i < kNumHandLandmarks; ++i) {
+    hand.x[i] = 0.5f + kPoints[i][0] / kAspectRatio;
+    hand.y[i] = 0.7f + kPoints[i][1];
+    hand.z[i] = kPoints[i][2] / kAspectRatio;
+  }
+  return hand;
+}
+
+// `hand` rotated by `angle` radians and scaled by `scale` in the image,
+// around its wrist, then moved by `dx`, `dy`, and mirrored left to right
+// when `mirror` is set.
+HandLandmarksSoA MoveHand(const HandLandmarksSoA& hand, float angle,
+                          float scale, float dx, float dy, bool mirror) {
+  const float c = std::cos(angle);
+  const float s = std::sin(angle);
+  HandLandmarksSoA moved = {};
+  for (int i = 0; i < kNumHandLandmarks; ++i) {
+    float x = kAspectRatio * (hand.x[i] - hand.x[0]);
+    const float y = hand.y[i] - hand.y[0];
+    if (mirror) x = -x;
+    moved.x[i] = hand.x[0] + dx + scale * (c * x - s * y) / kAspectRatio;
+    moved.y[i] = hand.y[0] + dy + scale * (s * x + c * y);
+    moved.z[i] = scale * (hand.z[i] - hand.z[0]);
+  }
+  return moved;
+}
+
+std::vector<float> InvariantFeatures(const HandLandmarksSoA& hand) {
+  std::vector<float> features(kInvariantFeatureSize);
+  ComputeInvariantFeatures(hand, HandRotationFromLandmarks(hand, kAspectRatio),
+                           kAspectRatio, features.data());
+  return features;
+}
+
+TEST(LandmarkFeaturesInvariantTest, MatchesScalar) {
+  std::mt19937 rng(20240611);
+  std::uniform_real_distribution<float> rotation(-3.1f, 3.1f);
+  std::uniform_real_distribution<float> aspect_ratio(0.5f, 2.f);
+  for (int n = 0; n < kNumRandomHands; ++n) {
+    const HandLandmarksSoA hand = RandomHand(&rng);
+    const float r = rotation(rng);
+    const float a = aspect_ratio(rng);
+    std::vector<float> actual(kInvariantFeatureSize + 1, kGuard);
+    std::vector<float> expected(kInvariantFeatureSize);
+    ComputeInvariantFeatures(hand, r, a, actual.data());
+    ComputeInvariantFeaturesScalar(hand, r, a, expected.data());
+    EXPECT_EQ(actual[kInvariantFeatureSize], kGuard) << "store past the output";
+    for (int i = 0; i < kInvariantFeatureSize; ++i) {
+      EXPECT_NEAR(actual[i], expected[i], kTolerance)
+          << "hand " << n << " feature " << i;
+    }
+  }
+}
+
+TEST(LandmarkFeaturesInvariantTest, PaddingLanesStayZero) {
+  std::mt19937 rng(1);
+  for (int n = 0; n < kNumRandomHands; ++n) {
+    const HandLandmarksSoA hand = RandomHand(&rng);
+    HandLandmarksSoA canonical;
+    for (int i = 0; i < kPaddedHandLandmarks; ++i) {
+      canonical.x[i] = canonical.y[i] = canonical.z[i] = kGuard;
+    }
+    CanonicalizeHand(hand, 0.4f, 0.75f, &canonical);
+    for (int i = kNumHandLandmarks; i < kPaddedHandLandmarks; ++i) {
+      EXPECT_EQ(canonical.x[i], 0.f) << "lane " << i;
+      EXPECT_EQ(canonical.y[i], 0.f) << "lane " << i;
+      EXPECT_EQ(canonical.z[i], 0.f) << "lane " << i;
+    }
+  }
+}
+
+TEST(LandmarkFeaturesInvariantTest, CanonicalHandIsUprightWithWristAtOrigin) {
+  const HandLandmarksSoA hand = MoveHand(OpenHand(), 0.9f, 1.f, 0.f, 0.f,
+                                         /*mirror=*/false);
+  HandLandmarksSoA canonical;
+  CanonicalizeHand(hand, HandRotationFromLandmarks(hand, kAspectRatio),
+                   kAspectRatio, &canonical);
+  EXPECT_NEAR(canonical.x[0], 0.f, kTolerance);
+  EXPECT_NEAR(canonical.y[0], 0.f, kTolerance);
+  // Middle finger base straight above the wrist, index left of the pinky.
+  EXPECT_NEAR(canonical.x[9], 0.f, kInvarianceTolerance);
+  EXPECT_LT(canonical.y[9], 0.f);
+  EXPECT_LT(canonical.x[5], canonical.x[17]);
+}
+
+TEST(LandmarkFeaturesInvariantTest, IgnoresPositionRotationSizeAndHandedness) {
+  const HandLandmarksSoA hand = OpenHand();
+  const std::vector<float> expected = InvariantFeatures(hand);
+  for (float angle : {-2.5f, -1.f, 0.3f, 1.7f, 3.f}) {
+    for (float scale : {0.5f, 1.3f}) {
+      for (bool mirror : {false, true}) {
+        const std::vector<float> actual = InvariantFeatures(
+            MoveHand(hand, angle, scale, -0.1f, 0.05f, mirror));
+        for (int i = 0; i < kInvariantFeatureSize; ++i) {
+          EXPECT_NEAR(actual[i], expected[i], kInvarianceTolerance)
+              << "angle " << angle << " scale " << scale << " mirror "
+              << mirror << " feature " << i;
+        }
+      }
+    }
+  }
+}
+
+}  // namespace
+}  // namespace mediapipe
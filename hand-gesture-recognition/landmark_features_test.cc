@@ -0,0 +1,92 @@
+#include "hand-gesture-recognition/landmark_features.h"
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "mediapipe/framework/port/gtest.h"
+
+namespace mediapipe {
+namespace {
+
+// The vectorized kernels reorder sums and use fused multiply-adds, so they
+// may differ from the scalar reference in the last bits. Features are all
+// of order one; 1e-5 is a few dozen ulps there.
+constexpr float kTolerance = 1e-5f;
+// Written around every output buffer to catch stores past the feature size.
+constexpr float kGuard = -12345.f;
+constexpr int kNumRandomHands = 200;
+
+HandLandmarksSoA RandomHand(std::mt19937* rng) {
+  std::uniform_real_distribution<float> coordinate(0.05f, 0.95f);
+  std::uniform_real_distribution<float> depth(-0.2f, 0.2f);
+  HandLandmarksSoA hand = {};
+  for (int i = 0; i < kNumHandLandmarks; ++i) {
+    hand.x[i] = coordinate(*rng);
+    hand.y[i] = coordinate(*rng);
+    hand.z[i] = depth(*rng);
+  }
+  return hand;
+}
+
+// Runs `kernel` into a guarded buffer of `size` floats and returns the
+// features. Fails when a guard value was overwritten.
+template <typename Kernel>
+std::vector<float> RunGuarded(int size, Kernel kernel) {
+  std::vector<float> buffer(size + 2 * kPaddedHandLandmarks, kGuard);
+  kernel(buffer.data() + kPaddedHandLandmarks);
+  for (int i = 0; i < kPaddedHandLandmarks; ++i) {
+    EXPECT_EQ(buffer[i], kGuard) << "store before the output at " << i;
+    EXPECT_EQ(buffer[kPaddedHandLandmarks + size + i], kGuard)
+        << "store past the output at " << size + i;
+  }
+  return std::vector<float>(buffer.begin() + kPaddedHandLandmarks,
+                            buffer.begin() + kPaddedHandLandmarks + size);
+}
+
+void ExpectNear(const std::vector<float>& actual,
+                const std::vector<float>& expected) {
+  ASSERT_EQ(actual.size(), expected.size());
+  for (size_t i = 0; i < actual.size(); ++i) {
+    EXPECT_NEAR(actual[i], expected[i], kTolerance) << "feature " << i;
+  }
+}
+
+class LandmarkFeaturesTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    std::mt19937 rng(20240611);
+    for (int i = 0; i < kNumRandomHands; ++i) {
+      hands_.push_back(RandomHand(&rng));
+    }
+  }
+
+  std::vector<HandLandmarksSoA> hands_;
+};
+
+TEST_F(LandmarkFeaturesTest, ZScoreMatchesScalar) {
+  for (const HandLandmarksSoA& hand : hands_) {
+    ExpectNear(RunGuarded(kZScoreFeatureSize,
+                          [&](float* out) {
+                            ComputeZScoreFeatures(hand, out);
+                          }),
+               RunGuarded(kZScoreFeatureSize, [&](float* out) {
+                 ComputeZScoreFeaturesScalar(hand, out);
+               }));
+  }
+}
+
+TEST_F(LandmarkFeaturesTest, PairwiseDistanceMatchesScalar) {
+  for (const HandLandmarksSoA& hand : hands_) {
+    ExpectNear(RunGuarded(kPairwiseDistanceFeatureSize,
+                          [&](float* out) {
+                            ComputePairwiseDistanceFeatures(hand, out);
+                          }),
+               RunGuarded(kPairwiseDistanceFeatureSize, [&](float* out) {
+                 ComputePairwiseDistanceFeaturesScalar(hand, out);
+               }));
+  }
+}
+
+}  // namespace
+}  // namespace mediapipe
@@ -0,0 +1,234 @@
+#include "hand-gesture-recognition/landmark_log.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <random>
+
+#include "absl/memory/memory.h"
+#include "mediapipe/framework/port/ret_check.h"
+
+namespace mediapipe {
+
+namespace {
+
+constexpr int64_t kSyntheticFrameIntervalUs = 33333;
+constexpr int kSyntheticPoseFrames = 30;
+
+struct FileCloser {
+  void operator()(std::FILE* file) const { std::fclose(file); }
+};
+using File = std::unique_ptr<std::FILE, FileCloser>;
+
+void SetLandmark(LandmarkLogRecord* record, int i, float x, float y, float z) {
+  record->landmarks[3 * i] = x;
+  record->landmarks[3 * i + 1] = y;
+  record->landmarks[3 * i + 2] = z;
+}
+
+// Right hand, fingers up, in a unit box around the wrist. `finger_mask` uses
+// the FingerBit layout of gesture_rules.h: bit 0 thumb, bits 1-4 the other
+// fingers from index to pinky.
+void SetHandPose(int finger_mask, float center_x, float center_y, float size,
+                 LandmarkLogRecord* record) {
+  auto set = [&](int i, float x, float y) {
+    SetLandmark(record, i, center_x + size * x, center_y + size * y, 0.f);
+  };
+  set(0, 0.f, 0.5f);
+  set(1, -0.15f, 0.35f);
+  set(2, -0.27f, 0.2f);
+  if (finger_mask & 1) {
+    set(3, -0.37f, 0.07f);
+    set(4, -0.47f, -0.05f);
+  } else {
+    set(3, -0.17f, 0.08f);
+    set(4, -0.05f, 0.f);
+  }
+  for (int finger = 0; finger < 4; ++finger) {
+    const int base = 5 + 4 * finger;
+    const float x = -0.13f + 0.13f * finger;
+    set(base, x, 0.f);
+    set(base + 1, x, -0.15f);
+    if (finger_mask & (2 << finger)) {
+      set(base + 2, x, -0.28f);
+      set(base + 3, x, -0.38f);
+    } else {
+      set(base + 2, x, -0.08f);
+      set(base + 3, x, -0.02f);
+    }
+  }
+}
+
+::mediapipe::Status CheckLandmarkLogHeader(const LandmarkLogHeader& header,
+                                           const std::string& path) {
+  RET_CHECK(std::memcmp(header.magic, kLandmarkLogMagic,
+                        sizeof(header.magic)) == 0)
+      << path << " is not a landmark log.";
+  RET_CHECK_EQ(header.version, kLandmarkLogVersion);
+  RET_CHECK_EQ(header.num_landmarks,
+               static_cast<uint32_t>(kNumHandLandmarks));
+  RET_CHECK_EQ(header.record_size, sizeof(LandmarkLogRecord));
+  return ::mediapipe::OkStatus();
+}
+
+}  // namespace
+
+LandmarkLogHeader MakeLandmarkLogHeader() {
+  LandmarkLogHeader header;
+  std::memcpy(header.magic, kLandmarkLogMagic, sizeof(header.magic));
+  header.version = kLandmarkLogVersion;
+  header.num_landmarks = kNumHandLandmarks;
+  header.record_size = sizeof(LandmarkLogRecord);
+  return header;
+}
+
+void ToLandmarkLogRecord(int64_t timestamp_us,
+                         const NormalizedLandmarkList& landmarks,
+                         const NormalizedRect& rect,
+                         LandmarkLogRecord* record) {
+  std::memset(record, 0, sizeof(*record));
+  record->timestamp_us = timestamp_us;
+  record->rect[0] = rect.x_center();
+  record->rect[1] = rect.y_center();
+  record->rect[2] = rect.width();
+  record->rect[3] = rect.height();
+  record->rect[4] = rect.rotation();
+  for (int i = 0; i < landmarks.landmark_size() && i < kNumHandLandmarks;
+       ++i) {
+    const auto& landmark = landmarks.landmark(i);
+    SetLandmark(record, i, landmark.x(), landmark.y(), landmark.z());
+  }
+}
+
+void FromLandmarkLogRecord(const LandmarkLogRecord& record,
+                           NormalizedLandmarkList* landmarks,
+                           NormalizedRect* rect) {
+  rect->set_x_center(record.rect[0]);
+  rect->set_y_center(record.rect[1]);
+  rect->set_width(record.rect[2]);
+  rect->set_height(record.rect[3]);
+  rect->set_rotation(record.rect[4]);
+  landmarks->clear_landmark();
+  if (!HasHand(record)) return;
+  for (int i = 0; i < kNumHandLandmarks; ++i) {
+    auto* landmark = landmarks->add_landmark();
+    landmark->set_x(record.landmarks[3 * i]);
+    landmark->set_y(record.landmarks[3 * i + 1]);
+    landmark->set_z(record.landmarks[3 * i + 2]);
+  }
+}
+
+bool HasHand(const LandmarkLogRecord& record) { return record.rect[2] > 0.f; }
+
+::mediapipe::Status WriteLandmarkLog(
+    const std::string& path, const std::vector<LandmarkLogRecord>& records) {
+  File file(std::fopen(path.c_str(), "wb"));
+  RET_CHECK(file) << "Cannot open " << path << " for writing.";
+  const LandmarkLogHeader header = MakeLandmarkLogHeader();
+  RET_CHECK_EQ(std::fwrite(&header, sizeof(header), 1, file.get()), 1u);
+  RET_CHECK_EQ(std::fwrite(records.data(), sizeof(LandmarkLogRecord),
+                           records.size(), file.get()),
+               records.size());
+  RET_CHECK_EQ(std::fflush(file.get()), 0) << "Failed to write " << path;
+  return ::mediapipe::OkStatus();
+}
+
+::mediapipe::Status ReadLandmarkLog(const std::string& path,
+                                    std::vector<LandmarkLogRecord>* records) {
+  File file(std::fopen(path.c_str(), "rb"));
+  RET_CHECK(file) << "Cannot open " << path;
+  LandmarkLogHeader header;
+  RET_CHECK_EQ(std::fread(&header, sizeof(header), 1, file.get()), 1u)
+      << path << " is too short for a landmark log.";
+  MP_RETURN_IF_ERROR(CheckLandmarkLogHeader(header, path));
+
+  records->clear();
+  LandmarkLogRecord record;
+  while (std::fread(&record, sizeof(record), 1, file.get()) == 1) {
+    records->push_back(record);
+  }
+  RET_CHECK(std::feof(file.get())) << "Failed to read " << path;
+  return ::mediapipe::OkStatus();
+}
+
+::mediapipe::StatusOr<std::unique_ptr<MappedLandmarkLog>>
+MappedLandmarkLog::Open(const std::string& path) {
+  const int fd = open(path.c_str(), O_RDONLY);
+  RET_CHECK_GE(fd, 0) << "Failed to open " << path;
+  struct stat file_stat;
+  const bool stat_ok = fstat(fd, &file_stat) == 0;
+  void* mapping = MAP_FAILED;
+  if (stat_ok && file_stat.st_size > 0) {
+    mapping = mmap(nullptr, file_stat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  }
+  // The mapping stays valid once the file is closed.
+  close(fd);
+  RET_CHECK(mapping != MAP_FAILED) << "Failed to map " << path;
+
+  auto log = absl::WrapUnique(new MappedLandmarkLog());
+  log->mapping_ = mapping;
+  log->mapping_size_ = file_stat.st_size;
+  // Replay reads the records in order.
+  madvise(mapping, log->mapping_size_, MADV_SEQUENTIAL);
+
+  RET_CHECK_GE(log->mapping_size_, sizeof(LandmarkLogHeader))
+      << path << " is too short for a landmark log.";
+  const auto* header = static_cast<const LandmarkLogHeader*>(mapping);
+  MP_RETURN_IF_ERROR(CheckLandmarkLogHeader(*header, path));
+  log->records_ = reinterpret_cast<const LandmarkLogRecord*>(header + 1);
+  log->num_records_ = (log->mapping_size_ - sizeof(LandmarkLogHeader)) /
+                      sizeof(LandmarkLogRecord);
+  return log;
+}
+
+MappedLandmarkLog::~MappedLandmarkLog() {
+  if (mapping_ != nullptr) {
+    munmap(mapping_, mapping_size_);
+  }
+}
+
+std::vector<LandmarkLogRecord> GenerateSyntheticLandmarkLog(int num_frames,
+                                                            uint32_t seed) {
+  std::mt19937 random(seed);
+  std::uniform_int_distribution<int> pose_distribution(0, 31);
+  std::uniform_real_distribution<float> unit(0.f, 1.f);
+  std::normal_distribution<float> jitter(0.f, 0.002f);
+
+  std::vector<LandmarkLogRecord> records(num_frames);
+  int finger_mask = 0;
+  bool hand_present = true;
+  for (int frame = 0; frame < num_frames; ++frame) {
+    LandmarkLogRecord& record = records[frame];
+    std::memset(&record, 0, sizeof(record));
+    record.timestamp_us = frame * kSyntheticFrameIntervalUs;
+
+    if (frame % kSyntheticPoseFrames == 0) {
+      finger_mask = pose_distribution(random);
+      // About one pose in ten shows no hand.
+      hand_present = unit(random) >= 0.1f;
+    }
+    if (!hand_present) continue;
+
+    const float t = frame / 30.f;
+    const float center_x = 0.5f + 0.15f * std::sin(0.7f * t);
+    const float center_y = 0.5f + 0.1f * std::sin(1.1f * t);
+    const float size = 0.25f + 0.05f * std::sin(0.3f * t);
+    SetHandPose(finger_mask, center_x, center_y, size, &record);
+    for (int i = 0; i < 3 * kNumHandLandmarks; ++i) {
+      record.landmarks[i] += jitter(random);
+    }
+    record.rect[0] = center_x;
+    record.rect[1] = center_y;
+    record.rect[2] = 1.2f * size;
+    record.rect[3] = 1.2f * size;
+  }
+  return records;
+}
+
+}  // namespace mediapipe
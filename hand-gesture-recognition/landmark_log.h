@@ -0,0 +1,103 @@
+#ifndef HAND_GESTURE_RECOGNITION_LANDMARK_LOG_H_
+#define HAND_GESTURE_RECOGNITION_LANDMARK_LOG_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "hand-gesture-recognition/landmark_features.h"
+#include "mediapipe/framework/formats/landmark.pb.h"
+#include "mediapipe/framework/formats/rect.pb.h"
+#include "mediapipe/framework/port/status.h"
+#include "mediapipe/framework/port/statusor.h"
+
+namespace mediapipe {
+
+// Recorded single-hand landmark streams, used to replay the gesture
+// calculators offline.
+//
+// A log is a LandmarkLogHeader followed by fixed-stride LandmarkLogRecords,
+// one per frame, in native byte order. A frame without a hand has a zero
+// rect width and zero landmarks.
+
+constexpr char kLandmarkLogMagic[4] = {'H', 'G', 'L', 'M'};
+constexpr uint32_t kLandmarkLogVersion = 1;
+
+struct LandmarkLogHeader {
+  char magic[4];
+  uint32_t version;
+  uint32_t num_landmarks;
+  uint32_t record_size;
+};
+
+struct LandmarkLogRecord {
+  int64_t timestamp_us;
+  // NormalizedRect x_center, y_center, width, height and rotation.
+  float rect[5];
+  // x, y, z of each landmark.
+  float landmarks[3 * kNumHandLandmarks];
+};
+
+static_assert(sizeof(LandmarkLogHeader) == 16, "Unexpected header padding.");
+static_assert(sizeof(LandmarkLogRecord) == 280, "Unexpected record padding.");
+
+// Header of a log holding LandmarkLogRecords.
+LandmarkLogHeader MakeLandmarkLogHeader();
+
+// Fills a record from the calculator inputs of one frame. Landmarks past
+// kNumHandLandmarks are dropped, missing ones are zero.
+void ToLandmarkLogRecord(int64_t timestamp_us,
+                         const NormalizedLandmarkList& landmarks,
+                         const NormalizedRect& rect,
+                         LandmarkLogRecord* record);
+
+// Inverse of ToLandmarkLogRecord. A frame without a hand gives an empty
+// landmark list.
+void FromLandmarkLogRecord(const LandmarkLogRecord& record,
+                           NormalizedLandmarkList* landmarks,
+                           NormalizedRect* rect);
+
+bool HasHand(const LandmarkLogRecord& record);
+
+::mediapipe::Status WriteLandmarkLog(
+    const std::string& path, const std::vector<LandmarkLogRecord>& records);
+
+::mediapipe::Status ReadLandmarkLog(const std::string& path,
+                                    std::vector<LandmarkLogRecord>* records);
+
+// Read-only, memory-mapped landmark log, for replaying long recordings
+// without reading them into memory first.
+class MappedLandmarkLog {
+ public:
+  // Maps the log at `path` and checks its header. A partially written last
+  // record, e.g. from a recording that was killed, is ignored.
+  static ::mediapipe::StatusOr<std::unique_ptr<MappedLandmarkLog>> Open(
+      const std::string& path);
+  ~MappedLandmarkLog();
+
+  MappedLandmarkLog(const MappedLandmarkLog&) = delete;
+  MappedLandmarkLog& operator=(const MappedLandmarkLog&) = delete;
+
+  int64_t num_records() const { return num_records_; }
+  const LandmarkLogRecord& record(int64_t i) const { return records_[i]; }
+
+ private:
+  MappedLandmarkLog() = default;
+
+  void* mapping_ = nullptr;
+  size_t mapping_size_ = 0;
+  const LandmarkLogRecord* records_ = nullptr;
+  int64_t num_records_ = 0;
+};
+
+// A right hand drifting around the image at 30 frames/s, cycling through
+// finger poses every second with some jitter, and leaving the image now and
+// then. Deterministic for a given seed.
+std::vector<LandmarkLogRecord> GenerateSyntheticLandmarkLog(int num_frames,
+                                                            uint32_t seed);
+
+}  // namespace mediapipe
+
+#endif  // HAND_GESTURE_RECOGNITION_LANDMARK_LOG_H_
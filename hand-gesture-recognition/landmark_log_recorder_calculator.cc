@@ -0,0 +1,109 @@
+#include <memory>
+
+#include "hand-gesture-recognition/landmark_log.h"
+#include "hand-gesture-recognition/landmark_log_recorder_calculator.pb.h"
+#include "hand-gesture-recognition/landmark_log_writer.h"
+#include "mediapipe/framework/calculator_framework.h"
+#include "mediapipe/framework/formats/landmark.pb.h"
+#include "mediapipe/framework/formats/rect.pb.h"
+#include "mediapipe/framework/port/ret_check.h"
+
+namespace mediapipe {
+
+namespace {
+
+constexpr char kNormLandmarksTag[] = "NORM_LANDMARKS";
+constexpr char kNormRectTag[] = "NORM_RECT";
+
+}  // namespace
+
+// Records the single-hand inputs of HandGestureRecognitionCalculator to a
+// landmark log (see landmark_log.h), so field sessions can be replayed with
+// LandmarkLogReplayCalculator or the offline benchmarks.
+//
+// Every NORM_RECT packet becomes one fixed-stride record with its timestamp,
+// the rect and the NORM_LANDMARKS of the same timestamp, if any. A frame
+// without landmarks is recorded as a frame without a hand. Records are copied
+// into a preallocated buffer; the file is written by a LandmarkLogWriter
+// thread, off the graph thread.
+//
+// Example config:
+// node {
+//   calculator: "LandmarkLogRecorderCalculator"
+//   input_stream: "NORM_LANDMARKS:hand_landmarks"
+//   input_stream: "NORM_RECT:hand_rect"
+//   node_options: {
+//     [type.googleapis.com/mediapipe.LandmarkLogRecorderCalculatorOptions] {
+//       output_path: "/sdcard/hand_landmarks.hglm"
+//     }
+//   }
+// }
+class LandmarkLogRecorderCalculator : public CalculatorBase {
+ public:
+  static ::mediapipe::Status GetContract(CalculatorContract* cc);
+
+  ::mediapipe::Status Open(CalculatorContext* cc) override;
+
+  ::mediapipe::Status Process(CalculatorContext* cc) override;
+
+  ::mediapipe::Status Close(CalculatorContext* cc) override;
+
+ private:
+  std::unique_ptr<LandmarkLogWriter> writer_;
+  LandmarkLogRecord record_;
+  const NormalizedLandmarkList no_landmarks_;
+};
+REGISTER_CALCULATOR(LandmarkLogRecorderCalculator);
+
+::mediapipe::Status LandmarkLogRecorderCalculator::GetContract(
+    CalculatorContract* cc) {
+  RET_CHECK(cc->Inputs().HasTag(kNormRectTag));
+  cc->Inputs().Tag(kNormRectTag).Set<NormalizedRect>();
+  if (cc->Inputs().HasTag(kNormLandmarksTag)) {
+    cc->Inputs().Tag(kNormLandmarksTag).Set<NormalizedLandmarkList>();
+  }
+  return ::mediapipe::OkStatus();
+}
+
+::mediapipe::Status LandmarkLogRecorderCalculator::Open(
+    CalculatorContext* cc) {
+  const auto& options = cc->Options<LandmarkLogRecorderCalculatorOptions>();
+  RET_CHECK(!options.output_path().empty()) << "output_path is required.";
+  ASSIGN_OR_RETURN(writer_,
+                   LandmarkLogWriter::Create(options.output_path(),
+                                             options.buffer_records()));
+  return ::mediapipe::OkStatus();
+}
+
+::mediapipe::Status LandmarkLogRecorderCalculator::Process(
+    CalculatorContext* cc) {
+  if (cc->Inputs().Tag(kNormRectTag).IsEmpty()) {
+    return ::mediapipe::OkStatus();
+  }
+  const auto& rect = cc->Inputs().Tag(kNormRectTag).Get<NormalizedRect>();
+  const NormalizedLandmarkList* landmarks = &no_landmarks_;
+  if (cc->Inputs().HasTag(kNormLandmarksTag) &&
+      !cc->Inputs().Tag(kNormLandmarksTag).IsEmpty()) {
+    landmarks =
+        &cc->Inputs().Tag(kNormLandmarksTag).Get<NormalizedLandmarkList>();
+  }
+  ToLandmarkLogRecord(cc->InputTimestamp().Value(), *landmarks, rect,
+                      &record_);
+  if (landmarks->landmark_size() == 0) {
+    // Replay tells hands apart by the rect width.
+    record_.rect[2] = 0.f;
+  }
+  return writer_->Append(record_);
+}
+
+::mediapipe::Status LandmarkLogRecorderCalculator::Close(
+    CalculatorContext* cc) {
+  if (!writer_) {
+    return ::mediapipe::OkStatus();
+  }
+  const ::mediapipe::Status status = writer_->Close();
+  writer_.reset();
+  return status;
+}
+
+}  // namespace mediapipe
@@ -0,0 +1,118 @@
+#include <memory>
+
+#include "absl/memory/memory.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
+#include "hand-gesture-recognition/landmark_log.h"
+#include "hand-gesture-recognition/landmark_log_replay_calculator.pb.h"
+#include "mediapipe/framework/calculator_framework.h"
+#include "mediapipe/framework/formats/landmark.pb.h"
+#include "mediapipe/framework/formats/rect.pb.h"
+#include "mediapipe/framework/port/ret_check.h"
+
+namespace mediapipe {
+
+namespace {
+
+constexpr char kNormLandmarksTag[] = "NORM_LANDMARKS";
+constexpr char kNormRectTag[] = "NORM_RECT";
+
+}  // namespace
+
+// Source calculator replaying a landmark log (see landmark_log.h), e.g. one
+// written by LandmarkLogRecorderCalculator, as the NORM_LANDMARKS and
+// NORM_RECT inputs of HandGestureRecognitionCalculator.
+//
+// The log is memory-mapped in Open() and read one record per Process(), so
+// arbitrarily long recordings start at once. Packets keep their recorded
+// timestamps, which makes runs deterministic. With `realtime`, each packet
+// waits until as much wall time has passed since the first one as in the
+// recording; otherwise the graph runs as fast as it can. A frame without a
+// hand gives an empty landmark list and a zero-size rect, as the hand tracking
+// graph does.
+//
+// Example config:
+// node {
+//   calculator: "LandmarkLogReplayCalculator"
+//   output_stream: "NORM_LANDMARKS:hand_landmarks"
+//   output_stream: "NORM_RECT:hand_rect"
+//   node_options: {
+//     [type.googleapis.com/mediapipe.LandmarkLogReplayCalculatorOptions] {
+//       log_path: "/tmp/hand_landmarks.hglm"
+//     }
+//   }
+// }
+class LandmarkLogReplayCalculator : public CalculatorBase {
+ public:
+  static ::mediapipe::Status GetContract(CalculatorContract* cc);
+
+  ::mediapipe::Status Open(CalculatorContext* cc) override;
+
+  ::mediapipe::Status Process(CalculatorContext* cc) override;
+
+ private:
+  std::unique_ptr<MappedLandmarkLog> log_;
+  int64_t next_record_ = 0;
+  bool realtime_ = false;
+  // Wall time of the first packet, and its recorded timestamp.
+  absl::Time start_time_;
+  int64_t start_timestamp_us_ = 0;
+};
+REGISTER_CALCULATOR(LandmarkLogReplayCalculator);
+
+::mediapipe::Status LandmarkLogReplayCalculator::GetContract(
+    CalculatorContract* cc) {
+  RET_CHECK(cc->Outputs().HasTag(kNormRectTag));
+  cc->Outputs().Tag(kNormRectTag).Set<NormalizedRect>();
+  if (cc->Outputs().HasTag(kNormLandmarksTag)) {
+    cc->Outputs().Tag(kNormLandmarksTag).Set<NormalizedLandmarkList>();
+  }
+  return ::mediapipe::OkStatus();
+}
+
+::mediapipe::Status LandmarkLogReplayCalculator::Open(CalculatorContext* cc) {
+  const auto& options = cc->Options<LandmarkLogReplayCalculatorOptions>();
+  RET_CHECK(!options.log_path().empty()) << "log_path is required.";
+  ASSIGN_OR_RETURN(log_, MappedLandmarkLog::Open(options.log_path()));
+  realtime_ = options.realtime();
+  return ::mediapipe::OkStatus();
+}
+
+::mediapipe::Status LandmarkLogReplayCalculator::Process(
+    CalculatorContext* cc) {
+  if (next_record_ == log_->num_records()) {
+    return tool::StatusStop();
+  }
+  const LandmarkLogRecord& record = log_->record(next_record_);
+  if (next_record_ == 0) {
+    start_time_ = absl::Now();
+    start_timestamp_us_ = record.timestamp_us;
+  } else {
+    RET_CHECK_GT(record.timestamp_us,
+                 log_->record(next_record_ - 1).timestamp_us)
+        << "Record " << next_record_ << " goes back in time.";
+  }
+  ++next_record_;
+
+  if (realtime_) {
+    const absl::Time due =
+        start_time_ +
+        absl::Microseconds(record.timestamp_us - start_timestamp_us_);
+    const absl::Duration wait = due - absl::Now();
+    if (wait > absl::ZeroDuration()) {
+      absl::SleepFor(wait);
+    }
+  }
+
+  auto landmarks = absl::make_unique<NormalizedLandmarkList>();
+  auto rect = absl::make_unique<NormalizedRect>();
+  FromLandmarkLogRecord(record, landmarks.get(), rect.get());
+  const Timestamp timestamp(record.timestamp_us);
+  if (cc->Outputs().HasTag(kNormLandmarksTag)) {
+    cc->Outputs().Tag(kNormLandmarksTag).Add(landmarks.release(), timestamp);
+  }
+  cc->Outputs().Tag(kNormRectTag).Add(rect.release(), timestamp);
+  return ::mediapipe::OkStatus();
+}
+
+}  // namespace mediapipe
@@ -0,0 +1,111 @@
+// Turns recorded landmark logs into a landmark dataset for
+// gesture_batch_classifier.
+//
+// Every frame with a hand becomes one sample; frames without a hand are
+// dropped. A recording usually holds one letter, so each log gets the label
+// at the same position in --log_labels, looked up in --label_map_path or
+// --labels as in GetGestureLabels. Logs without a label, or all of them when
+// --log_labels is empty, give unlabeled samples.
+//
+// Example, with the flags on one line:
+//
+//   bazel run -c opt //hand-gesture-recognition:landmark_log_to_dataset --
+//     --landmark_logs=/path/to/a.hglm,/path/to/b.hglm
+//     --log_labels=A,B
+//     --output_path=/path/to/poses.hgds
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/strings/str_split.h"
+#include "hand-gesture-recognition/gesture_label_map.h"
+#include "hand-gesture-recognition/landmark_dataset.h"
+#include "hand-gesture-recognition/landmark_log.h"
+#include "mediapipe/framework/port/commandlineflags.h"
+#include "mediapipe/framework/port/logging.h"
+#include "mediapipe/framework/port/ret_check.h"
+#include "mediapipe/framework/port/status.h"
+
+DEFINE_string(landmark_logs, "", "Comma-separated landmark logs.");
+DEFINE_string(log_labels, "",
+              "Comma-separated label of every log, empty for unlabeled.");
+DEFINE_string(labels, "ABCDEFGHIKLMNOPQRSTUVWXY",
+              "One character per classifier output, in output order. "
+              "Ignored when --label_map_path is set.");
+DEFINE_string(label_map_path, "",
+              "Label map of the classifier, one label per line.");
+DEFINE_string(output_path, "", "Where to write the dataset.");
+
+namespace mediapipe {
+
+namespace {
+
+::mediapipe::Status RunConverter() {
+  RET_CHECK(!FLAGS_landmark_logs.empty()) << "--landmark_logs is required.";
+  RET_CHECK(!FLAGS_output_path.empty()) << "--output_path is required.";
+  const std::vector<std::string> logs =
+      absl::StrSplit(FLAGS_landmark_logs, ',');
+  std::vector<std::string> log_labels;
+  if (!FLAGS_log_labels.empty()) {
+    log_labels = absl::StrSplit(FLAGS_log_labels, ',');
+    RET_CHECK_EQ(log_labels.size(), logs.size())
+        << "--log_labels needs one label per log.";
+  }
+  std::vector<std::string> labels;
+  MP_RETURN_IF_ERROR(
+      GetGestureLabels(FLAGS_label_map_path, FLAGS_labels, 0, &labels));
+
+  std::vector<int32_t> sample_labels;
+  std::vector<float> landmarks;
+  for (size_t i = 0; i < logs.size(); ++i) {
+    int32_t label = kUnlabeledSample;
+    if (!log_labels.empty() && !log_labels[i].empty()) {
+      label = std::find(labels.begin(), labels.end(), log_labels[i]) -
+              labels.begin();
+      RET_CHECK_LT(label, static_cast<int32_t>(labels.size()))
+          << "Label " << log_labels[i] << " of " << logs[i]
+          << " is not a classifier label.";
+    }
+    std::unique_ptr<MappedLandmarkLog> log;
+    ASSIGN_OR_RETURN(log, MappedLandmarkLog::Open(logs[i]));
+    int64_t num_hands = 0;
+    for (int64_t r = 0; r < log->num_records(); ++r) {
+      const LandmarkLogRecord& record = log->record(r);
+      if (!HasHand(record)) continue;
+      // Both hold x, y, z of each landmark.
+      landmarks.insert(landmarks.end(), record.landmarks,
+                       record.landmarks + kLandmarkDatasetRowSize);
+      sample_labels.push_back(label);
+      ++num_hands;
+    }
+    std::printf("%s: %lld frames, %lld with a hand\n", logs[i].c_str(),
+                static_cast<long long>(log->num_records()),
+                static_cast<long long>(num_hands));
+  }
+
+  RET_CHECK(!sample_labels.empty()) << "The logs have no hands.";
+  MP_RETURN_IF_ERROR(
+      WriteLandmarkDataset(FLAGS_output_path, sample_labels, landmarks));
+  std::printf("%zu samples\n", sample_labels.size());
+  return ::mediapipe::OkStatus();
+}
+
+}  // namespace
+
+}  // namespace mediapipe
+
+int main(int argc, char** argv) {
+  google::InitGoogleLogging(argv[0]);
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+  const ::mediapipe::Status status = ::mediapipe::RunConverter();
+  if (!status.ok()) {
+    LOG(ERROR) << "Failed to convert the logs: " << status.message();
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
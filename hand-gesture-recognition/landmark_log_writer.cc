@@ -0,0 +1,98 @@
+#include "hand-gesture-recognition/landmark_log_writer.h"
+
+#include <utility>
+
+#include "absl/memory/memory.h"
+#include "mediapipe/framework/port/canonical_errors.h"
+#include "mediapipe/framework/port/ret_check.h"
+
+namespace mediapipe {
+
+::mediapipe::StatusOr<std::unique_ptr<LandmarkLogWriter>>
+LandmarkLogWriter::Create(const std::string& path, int buffer_records) {
+  RET_CHECK_GT(buffer_records, 0);
+  std::FILE* file = std::fopen(path.c_str(), "wb");
+  RET_CHECK(file) << "Cannot open " << path << " for writing.";
+  const LandmarkLogHeader header = MakeLandmarkLogHeader();
+  if (std::fwrite(&header, sizeof(header), 1, file) != 1) {
+    std::fclose(file);
+    RET_CHECK_FAIL() << "Failed to write " << path;
+  }
+  return absl::WrapUnique(new LandmarkLogWriter(file, buffer_records));
+}
+
+LandmarkLogWriter::LandmarkLogWriter(std::FILE* file, int buffer_records)
+    : file_(file), buffer_records_(buffer_records) {
+  filling_.reserve(buffer_records_);
+  writing_.reserve(buffer_records_);
+  writer_ = std::thread([this] { Run(); });
+}
+
+LandmarkLogWriter::~LandmarkLogWriter() { Close().IgnoreError(); }
+
+::mediapipe::Status LandmarkLogWriter::Append(
+    const LandmarkLogRecord& record) {
+  filling_.push_back(record);
+  if (filling_.size() == buffer_records_) {
+    SubmitFilled();
+  }
+  absl::MutexLock lock(&mutex_);
+  return status_;
+}
+
+void LandmarkLogWriter::SubmitFilled() {
+  absl::MutexLock lock(&mutex_);
+  mutex_.Await(absl::Condition(this, &LandmarkLogWriter::WriterIdle));
+  // Both keep their capacity, nothing is allocated.
+  std::swap(filling_, writing_);
+}
+
+::mediapipe::Status LandmarkLogWriter::Close() {
+  if (file_ == nullptr) {
+    return ::mediapipe::OkStatus();
+  }
+  if (!filling_.empty()) {
+    SubmitFilled();
+  }
+  {
+    absl::MutexLock lock(&mutex_);
+    stopping_ = true;
+  }
+  writer_.join();
+  const bool closed = std::fclose(file_) == 0;
+  file_ = nullptr;
+  MP_RETURN_IF_ERROR(status_);
+  RET_CHECK(closed) << "Failed to close the landmark log.";
+  return ::mediapipe::OkStatus();
+}
+
+bool LandmarkLogWriter::HasWork() const {
+  return stopping_ || !writing_.empty();
+}
+
+bool LandmarkLogWriter::WriterIdle() const { return writing_.empty(); }
+
+void LandmarkLogWriter::Run() {
+  while (true) {
+    {
+      absl::MutexLock lock(&mutex_);
+      mutex_.Await(absl::Condition(this, &LandmarkLogWriter::HasWork));
+      if (writing_.empty()) {
+        // Stopping, and everything is written.
+        return;
+      }
+    }
+    // The caller leaves `writing_` alone until it is empty again.
+    const size_t written = std::fwrite(
+        writing_.data(), sizeof(LandmarkLogRecord), writing_.size(), file_);
+    const bool flushed = std::fflush(file_) == 0;
+    absl::MutexLock lock(&mutex_);
+    if (status_.ok() && (written != writing_.size() || !flushed)) {
+      status_ =
+          ::mediapipe::InternalError("Failed to write the landmark log.");
+    }
+    writing_.clear();
+  }
+}
+
+}  // namespace mediapipe
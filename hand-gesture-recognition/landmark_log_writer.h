@@ -0,0 +1,70 @@
+#ifndef HAND_GESTURE_RECOGNITION_LANDMARK_LOG_WRITER_H_
+#define HAND_GESTURE_RECOGNITION_LANDMARK_LOG_WRITER_H_
+
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "absl/synchronization/mutex.h"
+#include "hand-gesture-recognition/landmark_log.h"
+#include "mediapipe/framework/port/status.h"
+#include "mediapipe/framework/port/statusor.h"
+
+namespace mediapipe {
+
+// Appends LandmarkLogRecords to a landmark log from a real-time thread.
+//
+// Records are copied into one of two preallocated buffers. A full buffer is
+// handed to a writer thread, which does the file I/O while the caller fills
+// the other one, so Append() neither allocates nor touches the file. It
+// only waits when the writer is still busy with the previous buffer once
+// the next one is full, i.e. when the disk cannot keep up.
+class LandmarkLogWriter {
+ public:
+  // Creates the log at `path`, writes its header and starts the writer.
+  // Records reach the file `buffer_records` at a time.
+  static ::mediapipe::StatusOr<std::unique_ptr<LandmarkLogWriter>> Create(
+      const std::string& path, int buffer_records);
+  // Calls Close().
+  ~LandmarkLogWriter();
+
+  LandmarkLogWriter(const LandmarkLogWriter&) = delete;
+  LandmarkLogWriter& operator=(const LandmarkLogWriter&) = delete;
+
+  // Queues `record`. Returns the error of an earlier write, if any.
+  ::mediapipe::Status Append(const LandmarkLogRecord& record);
+
+  // Writes the pending records, stops the writer and closes the file.
+  // Returns the first write error. Later calls do nothing.
+  ::mediapipe::Status Close();
+
+ private:
+  LandmarkLogWriter(std::FILE* file, int buffer_records);
+
+  // Hands the filled buffer to the writer, after the previous one is
+  // written.
+  void SubmitFilled();
+  void Run();
+  bool HasWork() const;
+  bool WriterIdle() const;
+
+  std::FILE* file_;
+  const size_t buffer_records_;
+  // Filled by the caller.
+  std::vector<LandmarkLogRecord> filling_;
+  // Written by the writer thread, empty when it is idle. Only swapped or
+  // cleared with `mutex_` held.
+  std::vector<LandmarkLogRecord> writing_;
+
+  absl::Mutex mutex_;
+  bool stopping_ = false;
+  ::mediapipe::Status status_;
+
+  std::thread writer_;
+};
+
+}  // namespace mediapipe
+
+#endif  // HAND_GESTURE_RECOGNITION_LANDMARK_LOG_WRITER_H_
@@ -0,0 +1,80 @@
+#include "hand-gesture-recognition/landmark_sequence_window.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace mediapipe {
+
+namespace {
+
+constexpr int kWrist = 0;
+constexpr int kIndexTip = 8;
+constexpr int kPinkyTip = 20;
+
+}  // namespace
+
+constexpr int LandmarkSequenceWindow::kFrameSize;
+
+LandmarkSequenceWindow::LandmarkSequenceWindow(int window_size)
+    : window_size_(std::max(window_size, 1)),
+      frames_(2 * window_size_ * kFrameSize),
+      tip_travel_(window_size_) {}
+
+void LandmarkSequenceWindow::Reset() {
+  head_ = 0;
+  size_ = 0;
+  tip_path_length_ = 0.f;
+  previous_hand_size_ = 0.f;
+}
+
+void LandmarkSequenceWindow::Push(const HandLandmarksSoA& hand,
+                                  float hand_size) {
+  int slot;
+  // Tip travel of the frame leaving the window.
+  float evicted = 0.f;
+  if (full()) {
+    slot = head_;
+    evicted = tip_travel_[slot];
+    head_ = head_ + 1 == window_size_ ? 0 : head_ + 1;
+  } else {
+    slot = head_ + size_;
+    ++size_;
+  }
+  float* frame = frames_.data() + slot * kFrameSize;
+
+  ComputeZScoreFeatures(hand, frame);
+  float* velocity = frame + kZScoreFeatureSize;
+  float tip_travel = 0.f;
+  if (previous_hand_size_ > 0.f && hand_size > 0.f) {
+    const float scale = 1.f / hand_size;
+    int v = 0;
+    for (int landmark : {kWrist, kIndexTip, kPinkyTip}) {
+      const float dx = (hand.x[landmark] - previous_.x[landmark]) * scale;
+      const float dy = (hand.y[landmark] - previous_.y[landmark]) * scale;
+      velocity[v++] = dx;
+      velocity[v++] = dy;
+      if (landmark != kWrist) {
+        tip_travel += std::sqrt(dx * dx + dy * dy);
+      }
+    }
+  } else {
+    std::fill(velocity, velocity + 6, 0.f);
+  }
+  std::copy(frame, frame + kFrameSize,
+            frames_.data() + (slot + window_size_) * kFrameSize);
+
+  // Running sum, rebuilt whenever the ring wraps so rounding cannot drift.
+  tip_path_length_ += tip_travel - evicted;
+  tip_travel_[slot] = tip_travel;
+  if (slot == window_size_ - 1) {
+    tip_path_length_ = 0.f;
+    for (int i = 0; i < size_; ++i) {
+      tip_path_length_ += tip_travel_[i];
+    }
+  }
+
+  previous_ = hand;
+  previous_hand_size_ = hand_size;
+}
+
+}  // namespace mediapipe
@@ -0,0 +1,63 @@
+#ifndef HAND_GESTURE_RECOGNITION_LANDMARK_SEQUENCE_WINDOW_H_
+#define HAND_GESTURE_RECOGNITION_LANDMARK_SEQUENCE_WINDOW_H_
+
+#include <vector>
+
+#include "hand-gesture-recognition/landmark_features.h"
+
+namespace mediapipe {
+
+// Features of the last `window_size` frames of one hand, the input of the
+// motion letter (J, Z) model.
+//
+// Each frame is turned into kFrameSize floats once, when it is pushed: the
+// hand shape, as the z-scores the letter classifier uses, and the x, y
+// velocity of the wrist, index tip and pinky tip since the previous frame,
+// in hand sizes. Nothing is recomputed when the window slides.
+//
+// Frames live in a ring buffer written twice, at slot i and i + window_size,
+// so the window is always one contiguous block, oldest frame first, that can
+// be copied straight into the model input. All storage is allocated in the
+// constructor.
+class LandmarkSequenceWindow {
+ public:
+  static constexpr int kFrameSize = kZScoreFeatureSize + 6;
+
+  explicit LandmarkSequenceWindow(int window_size);
+
+  // Adds a frame. `hand_size` scales the velocities, e.g. the larger side of
+  // the hand rect.
+  void Push(const HandLandmarksSoA& hand, float hand_size);
+
+  // Forgets all frames, e.g. when the hand is lost.
+  void Reset();
+
+  int window_size() const { return window_size_; }
+  bool full() const { return size_ == window_size_; }
+
+  // window_size() * kFrameSize floats, oldest frame first. Only meaningful
+  // when full().
+  const float* data() const { return frames_.data() + head_ * kFrameSize; }
+
+  // Distance the index and pinky tips travelled over the window, in hand
+  // sizes. A cheap test for whether a motion letter is possible at all.
+  float tip_path_length() const { return tip_path_length_; }
+
+ private:
+  int window_size_;
+  // 2 * window_size frames.
+  std::vector<float> frames_;
+  // Tip travel of every frame, by slot.
+  std::vector<float> tip_travel_;
+  // Slot of the oldest frame and number of frames.
+  int head_ = 0;
+  int size_ = 0;
+  float tip_path_length_ = 0.f;
+
+  HandLandmarksSoA previous_;
+  float previous_hand_size_ = 0.f;
+};
+
+}  // namespace mediapipe
+
+#endif  // HAND_GESTURE_RECOGNITION_LANDMARK_SEQUENCE_WINDOW_H_
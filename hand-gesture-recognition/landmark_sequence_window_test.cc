@@ -0,0 +1,123 @@
+#include "hand-gesture-recognition/landmark_sequence_window.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "hand-gesture-recognition/landmark_features.h"
+#include "mediapipe/framework/port/gtest.h"
+
+namespace mediapipe {
+namespace {
+
+constexpr int kWindowSize = 4;
+constexpr float kHandSize = 0.25f;
+
+// A hand moved by `dx` along x. Landmark 3, neither the wrist nor a tip,
+// also moves with `frame`, so every frame has its own shape while the
+// velocities only see the translation.
+HandLandmarksSoA MakeHand(int frame, float dx) {
+  HandLandmarksSoA hand = {};
+  for (int i = 0; i < kNumHandLandmarks; ++i) {
+    hand.x[i] = 0.3f + 0.01f * i + dx;
+    hand.y[i] = 0.7f - 0.02f * i + 0.005f * (i % 4);
+  }
+  hand.y[3] += 0.001f * frame;
+  return hand;
+}
+
+// The kFrameSize features LandmarkSequenceWindow should store for `hand`.
+std::vector<float> ExpectedFrame(const HandLandmarksSoA& hand,
+                                 const HandLandmarksSoA* previous) {
+  std::vector<float> frame(LandmarkSequenceWindow::kFrameSize, 0.f);
+  ComputeZScoreFeatures(hand, frame.data());
+  if (previous != nullptr) {
+    int v = kZScoreFeatureSize;
+    for (int landmark : {0, 8, 20}) {
+      frame[v++] = (hand.x[landmark] - previous->x[landmark]) / kHandSize;
+      frame[v++] = (hand.y[landmark] - previous->y[landmark]) / kHandSize;
+    }
+  }
+  return frame;
+}
+
+TEST(LandmarkSequenceWindowTest, KeepsTheLastFramesOldestFirst) {
+  LandmarkSequenceWindow window(kWindowSize);
+  std::vector<std::vector<float>> expected;
+  HandLandmarksSoA previous;
+  // Enough frames to wrap the ring several times.
+  for (int frame = 0; frame < 3 * kWindowSize + 1; ++frame) {
+    const HandLandmarksSoA hand = MakeHand(frame, 0.002f * frame * frame);
+    window.Push(hand, kHandSize);
+    expected.push_back(ExpectedFrame(hand, frame > 0 ? &previous : nullptr));
+    previous = hand;
+
+    EXPECT_EQ(window.full(), frame + 1 >= kWindowSize) << "frame " << frame;
+    if (!window.full()) continue;
+    for (int k = 0; k < kWindowSize; ++k) {
+      const std::vector<float>& want = expected[frame + 1 - kWindowSize + k];
+      const float* got =
+          window.data() + k * LandmarkSequenceWindow::kFrameSize;
+      for (int i = 0; i < LandmarkSequenceWindow::kFrameSize; ++i) {
+        EXPECT_NEAR(got[i], want[i], 1e-5f)
+            << "frame " << frame << " slot " << k << " feature " << i;
+      }
+    }
+  }
+}
+
+TEST(LandmarkSequenceWindowTest, PathLengthCoversTheWindowOnly) {
+  LandmarkSequenceWindow window(kWindowSize);
+  std::vector<float> steps;
+  float x = 0.f;
+  for (int frame = 0; frame < 10 * kWindowSize; ++frame) {
+    // Alternating step sizes, so each window position sums differently.
+    const float step = frame % 3 == 0 ? 0.01f : 0.003f * (frame % 5);
+    x += step;
+    window.Push(MakeHand(frame, x), kHandSize);
+    // The first frame has no velocity. Both tips move by `step`.
+    steps.push_back(frame == 0 ? 0.f : 2.f * step / kHandSize);
+
+    float expected = 0.f;
+    const int first = std::max(0, frame + 1 - kWindowSize);
+    for (int i = first; i <= frame; ++i) expected += steps[i];
+    EXPECT_NEAR(window.tip_path_length(), expected, 1e-4f)
+        << "frame " << frame;
+  }
+}
+
+TEST(LandmarkSequenceWindowTest, ResetForgetsFramesAndMotion) {
+  LandmarkSequenceWindow window(kWindowSize);
+  for (int frame = 0; frame < kWindowSize + 2; ++frame) {
+    window.Push(MakeHand(frame, 0.01f * frame), kHandSize);
+  }
+  ASSERT_TRUE(window.full());
+  ASSERT_GT(window.tip_path_length(), 0.f);
+
+  window.Reset();
+  EXPECT_FALSE(window.full());
+  EXPECT_EQ(window.tip_path_length(), 0.f);
+
+  // The first frame after Reset() has no previous frame to move from.
+  window.Push(MakeHand(0, 0.5f), kHandSize);
+  EXPECT_EQ(window.tip_path_length(), 0.f);
+  for (int frame = 1; frame < kWindowSize; ++frame) {
+    window.Push(MakeHand(frame, 0.5f), kHandSize);
+  }
+  ASSERT_TRUE(window.full());
+  for (int i = 0; i < 6; ++i) {
+    EXPECT_EQ(window.data()[kZScoreFeatureSize + i], 0.f);
+  }
+}
+
+TEST(LandmarkSequenceWindowTest, ZeroHandSizeGivesNoVelocity) {
+  LandmarkSequenceWindow window(1);
+  window.Push(MakeHand(0, 0.f), kHandSize);
+  window.Push(MakeHand(1, 0.1f), 0.f);
+  EXPECT_EQ(window.tip_path_length(), 0.f);
+  for (int i = 0; i < 6; ++i) {
+    EXPECT_EQ(window.data()[kZScoreFeatureSize + i], 0.f);
+  }
+}
+
+}  // namespace
+}  // namespace mediapipe
@@ -0,0 +1,66 @@
+#ifndef HAND_GESTURE_RECOGNITION_LATEST_VALUE_MAILBOX_H_
+#define HAND_GESTURE_RECOGNITION_LATEST_VALUE_MAILBOX_H_
+
+#include <atomic>
+#include <cstdint>
+
+namespace mediapipe {
+
+// Lock-free single-slot mailbox between one writer and one reader thread,
+// where only the latest value matters.
+//
+// Three preallocated values rotate between the writer, the slot and the
+// reader (triple buffering), so neither side ever waits or allocates. A value
+// published before the reader took the previous one replaces it; the writer
+// gets the stale value back and can tell which one was dropped.
+template <typename T>
+class LatestValueMailbox {
+ public:
+  explicit LatestValueMailbox(const T& prototype)
+      : values_{prototype, prototype, prototype} {}
+
+  LatestValueMailbox(const LatestValueMailbox&) = delete;
+  LatestValueMailbox& operator=(const LatestValueMailbox&) = delete;
+
+  // Writer side. The value to fill before Publish().
+  T* writer_value() { return &values_[writer_]; }
+
+  // Writer side. Hands writer_value() to the reader. Returns true if this
+  // dropped a value the reader never took; writer_value() is then that value.
+  bool Publish() {
+    const uint32_t previous =
+        slot_.exchange(writer_ | kFresh, std::memory_order_acq_rel);
+    writer_ = previous & kIndexMask;
+    return previous & kFresh;
+  }
+
+  // Reader side. Whether a value was published since the last Take().
+  bool HasFresh() const {
+    return slot_.load(std::memory_order_acquire) & kFresh;
+  }
+
+  // Reader side. The latest published value, or nullptr if there is nothing
+  // new. Valid until the next Take().
+  T* Take() {
+    if (!HasFresh()) return nullptr;
+    // Only the writer touches the slot meanwhile, and it keeps it fresh.
+    const uint32_t previous =
+        slot_.exchange(reader_, std::memory_order_acq_rel);
+    reader_ = previous & kIndexMask;
+    return &values_[reader_];
+  }
+
+ private:
+  static constexpr uint32_t kIndexMask = 3;
+  static constexpr uint32_t kFresh = 4;
+
+  T values_[3];
+  // Index of the value in the slot, plus kFresh until the reader takes it.
+  std::atomic<uint32_t> slot_{1};
+  uint32_t writer_ = 0;
+  uint32_t reader_ = 2;
+};
+
+}  // namespace mediapipe
+
+#endif  // HAND_GESTURE_RECOGNITION_LATEST_VALUE_MAILBOX_H_
@@ -0,0 +1,97 @@
+#include "hand-gesture-recognition/latest_value_mailbox.h"
+
+#include <array>
+#include <cstdint>
+#include <thread>
+
+#include "mediapipe/framework/port/gtest.h"
+
+namespace mediapipe {
+namespace {
+
+TEST(LatestValueMailboxTest, EmptyUntilPublished) {
+  LatestValueMailbox<int> mailbox(0);
+  EXPECT_FALSE(mailbox.HasFresh());
+  EXPECT_EQ(mailbox.Take(), nullptr);
+
+  *mailbox.writer_value() = 1;
+  EXPECT_FALSE(mailbox.Publish());
+  EXPECT_TRUE(mailbox.HasFresh());
+  const int* value = mailbox.Take();
+  ASSERT_NE(value, nullptr);
+  EXPECT_EQ(*value, 1);
+  EXPECT_FALSE(mailbox.HasFresh());
+  EXPECT_EQ(mailbox.Take(), nullptr);
+}
+
+TEST(LatestValueMailboxTest, LatestValueWins) {
+  LatestValueMailbox<int> mailbox(0);
+  *mailbox.writer_value() = 1;
+  EXPECT_FALSE(mailbox.Publish());
+  *mailbox.writer_value() = 2;
+  // 1 was never taken: it is dropped and handed back to the writer.
+  EXPECT_TRUE(mailbox.Publish());
+  EXPECT_EQ(*mailbox.writer_value(), 1);
+  *mailbox.writer_value() = 3;
+  EXPECT_TRUE(mailbox.Publish());
+  EXPECT_EQ(*mailbox.writer_value(), 2);
+
+  const int* value = mailbox.Take();
+  ASSERT_NE(value, nullptr);
+  EXPECT_EQ(*value, 3);
+  EXPECT_EQ(mailbox.Take(), nullptr);
+}
+
+TEST(LatestValueMailboxTest, ReaderKeepsItsValueWhileWriterPublishes) {
+  LatestValueMailbox<int> mailbox(0);
+  *mailbox.writer_value() = 1;
+  mailbox.Publish();
+  const int* taken = mailbox.Take();
+  ASSERT_NE(taken, nullptr);
+  for (int i = 2; i < 10; ++i) {
+    *mailbox.writer_value() = i;
+    mailbox.Publish();
+    EXPECT_EQ(*taken, 1);
+  }
+  EXPECT_EQ(*mailbox.Take(), 9);
+}
+
+// A value larger than any atomic store, so a torn read shows as mixed
+// sequence numbers.
+struct Payload {
+  int64_t sequence = -1;
+  std::array<int64_t, 64> copies = {};
+};
+
+TEST(LatestValueMailboxTest, NoTornReadsAcrossThreads) {
+  constexpr int64_t kNumValues = 200000;
+  LatestValueMailbox<Payload> mailbox{Payload()};
+
+  std::thread writer([&mailbox] {
+    for (int64_t i = 0; i < kNumValues; ++i) {
+      Payload* payload = mailbox.writer_value();
+      payload->sequence = i;
+      payload->copies.fill(i);
+      mailbox.Publish();
+    }
+  });
+
+  int64_t last_sequence = -1;
+  auto check = [&](const Payload& payload) {
+    EXPECT_GT(payload.sequence, last_sequence);
+    for (int64_t copy : payload.copies) {
+      ASSERT_EQ(copy, payload.sequence);
+    }
+    last_sequence = payload.sequence;
+  };
+  while (last_sequence < kNumValues - 1) {
+    if (const Payload* payload = mailbox.Take()) check(*payload);
+  }
+  writer.join();
+
+  EXPECT_EQ(last_sequence, kNumValues - 1);
+  EXPECT_EQ(mailbox.Take(), nullptr);
+}
+
+}  // namespace
+}  // namespace mediapipe
@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include "absl/memory/memory.h"
+#include "hand-gesture-recognition/string_to_render_data_calculator.pb.h"
 #include "mediapipe/framework/calculator_framework.h"
 #include "mediapipe/framework/calculator_options.pb.h"
 #include "mediapipe/framework/port/ret_check.h"
@@ -24,9 +25,6 @@ namespace {
 
 constexpr char kTextTag[] = "TEXT";
 constexpr char kRenderDataTag[] = "RENDER_DATA";
-constexpr double kTextLineXPos = 0.055;
-constexpr double kTextLineHeight = 0.05;
-constexpr double kTextFontHeight = 0.05;
 
 }  // namespace
 
@@ -35,9 +33,12 @@ constexpr double kTextFontHeight = 0.05;
 //
 // The input can be std::string.
 //
-// Please note that this calculator displays the string on the top left corner
-// of the image by using normalized coordinates (0, 0). Modify the calculator
-// to accept a location for the string.
+// The position, color and font of the text come from
+// StringToRenderDataCalculatorOptions and are baked into a RenderData template
+// once in Open(). By default a text equal to the previous one produces no
+// packet, only a timestamp bound update, so the annotation overlay is not
+// redrawn for unchanged text. With skip_unchanged_text off, the previous
+// RenderData packet is re-emitted instead of being rebuilt.
 //
 // Example config:
 // node {
@@ -60,6 +61,13 @@ class StringToRenderDataCalculator : public CalculatorBase {
 
   ::mediapipe::Status Process(CalculatorContext* cc) override;
 
+ private:
+  StringToRenderDataCalculatorOptions options_;
+  // Every field except the display text, built once in Open().
+  RenderData render_data_template_;
+  std::string last_text_;
+  // RenderData of `last_text_`, shared by every frame showing the same text.
+  Packet last_render_data_;
 };
 REGISTER_CALCULATOR(StringToRenderDataCalculator);
 
@@ -83,6 +91,24 @@ REGISTER_CALCULATOR(StringToRenderDataCalculator);
   // output packet is generated.
   cc->SetOffset(TimestampDiff(0));
 
+  options_ = cc->Options<StringToRenderDataCalculatorOptions>();
+  render_data_template_.set_scene_class("TEXT");
+  auto* text_annotation = render_data_template_.add_render_annotations();
+  if (options_.has_color()) {
+    *text_annotation->mutable_color() = options_.color();
+  } else {
+    text_annotation->mutable_color()->set_r(0);
+    text_annotation->mutable_color()->set_g(255);
+    text_annotation->mutable_color()->set_b(255);
+  }
+  text_annotation->set_thickness(options_.thickness());
+
+  auto* text = text_annotation->mutable_text();
+  text->set_normalized(true);
+  text->set_left(options_.left());
+  text->set_baseline(options_.baseline());
+  text->set_font_height(options_.font_height());
+
   return ::mediapipe::OkStatus();
 }
 
@@ -93,30 +119,26 @@ REGISTER_CALCULATOR(StringToRenderDataCalculator);
     return ::mediapipe::OkStatus();
   }
 
-  auto render_data = absl::make_unique<RenderData>();
-  render_data->set_scene_class("TEXT");
-
   const std::string& text_string =
       cc->Inputs().Tag(kTextTag).Get<std::string>();
+  if (!last_render_data_.IsEmpty() && text_string == last_text_) {
+    if (!options_.skip_unchanged_text()) {
+      cc->Outputs()
+          .Tag(kRenderDataTag)
+          .AddPacket(last_render_data_.At(cc->InputTimestamp()));
+    }
+    return ::mediapipe::OkStatus();
+  }
+  last_text_ = text_string;
 
-  auto* text_annotation = render_data->add_render_annotations();
-  text_annotation->mutable_color()->set_r(0);
-  text_annotation->mutable_color()->set_g(255);
-  text_annotation->mutable_color()->set_b(255);
-  text_annotation->set_thickness(4.0);
-
-  auto* text = text_annotation->mutable_text();
-  text->set_display_text(text_string);
-  LOG(INFO) << "Displaying text: " << text_string;
-  
-  text->set_normalized(true);
-  text->set_left(kTextLineXPos);
-  text->set_baseline(kTextLineHeight);
-  text->set_font_height(kTextFontHeight);
+  auto render_data = absl::make_unique<RenderData>(render_data_template_);
+  render_data->mutable_render_annotations(0)->mutable_text()->set_display_text(
+      text_string);
+  last_render_data_ = Adopt(render_data.release());
 
   cc->Outputs()
       .Tag(kRenderDataTag)
-      .Add(render_data.release(), cc->InputTimestamp());
+      .AddPacket(last_render_data_.At(cc->InputTimestamp()));
   return ::mediapipe::OkStatus();
 }
 
@@ -0,0 +1,314 @@
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/memory/memory.h"
+#include "hand-gesture-recognition/gesture_classification.h"
+#include "hand-gesture-recognition/gesture_label_map.h"
+#include "hand-gesture-recognition/word_assembly_calculator.pb.h"
+#include "hand-gesture-recognition/word_dictionary.h"
+#include "mediapipe/framework/calculator_framework.h"
+#include "mediapipe/framework/port/ret_check.h"
+
+namespace mediapipe {
+
+namespace {
+
+constexpr char kTextTag[] = "TEXT";
+constexpr char kClassificationTag[] = "CLASSIFICATION";
+constexpr char kWordTag[] = "WORD";
+constexpr char kSuggestionsTag[] = "SUGGESTIONS";
+constexpr char kSentenceTag[] = "SENTENCE";
+
+// Letters are single upper-case characters; anything else on the input
+// ("No Hand Detected", the unknown label...) counts as no letter.
+char ToLetter(const std::string& text) {
+  return text.size() == 1 && text[0] >= 'A' && text[0] <= 'Z' ? text[0] : 0;
+}
+
+}  // namespace
+
+// Assembles the letters of the ASL stream into words and sentences.
+//
+// The input is either TEXT or CLASSIFICATION, the ASL or CLASSIFICATION
+// output of HandGestureRecognitionCalculator. A GestureClassification counts
+// as a letter when its calibrated confidence reaches min_letter_confidence.
+// The recognizer only outputs the first frame without a hand, then only
+// advances the timestamp bound. Process() also runs on these bound updates,
+// so a word or sentence ends as soon as its gap has passed, without waiting
+// for the hand to come back.
+//
+// A letter is added to the word once it has been shown for
+// min_letter_duration_us, and again every letter_repeat_us while it is held.
+// The word ends after word_gap_us without a letter, the sentence after
+// sentence_gap_us.
+//
+// With a dictionary, the word being signed is followed in a memory-mapped
+// trie (see WordDictionary) one letter at a time, so each new letter costs
+// one child lookup. Its most frequent completions are output on SUGGESTIONS
+// whenever the word changes, and a finished word that is not in the
+// dictionary is corrected to the closest frequent one.
+//
+// Outputs only carry packets when something changes: WORD once per finished
+// word, SENTENCE once per finished sentence (its words separated by spaces),
+// SUGGESTIONS once per letter and, empty, when the word ends. Pending words
+// and sentences are output in Close().
+//
+// Example config:
+// node {
+//   calculator: "WordAssemblyCalculator"
+//   input_stream: "TEXT:recognized_hand_gesture"
+//   output_stream: "WORD:word"
+//   output_stream: "SUGGESTIONS:word_suggestions"
+//   output_stream: "SENTENCE:sentence"
+//   node_options: {
+//     [type.googleapis.com/mediapipe.WordAssemblyCalculatorOptions] {
+//       dictionary_path: "mediapipe/models/asl_words.dict"
+//     }
+//   }
+// }
+class WordAssemblyCalculator : public CalculatorBase {
+ public:
+  static ::mediapipe::Status GetContract(CalculatorContract* cc);
+
+  ::mediapipe::Status Open(CalculatorContext* cc) override;
+
+  ::mediapipe::Status Process(CalculatorContext* cc) override;
+
+  ::mediapipe::Status Close(CalculatorContext* cc) override;
+
+ private:
+  // Outputs go at `timestamp`: the input timestamp, or right after the last
+  // one in Close().
+  void AddLetter(char letter, Timestamp timestamp, CalculatorContext* cc);
+  void FinishWord(Timestamp timestamp, CalculatorContext* cc);
+  void FinishSentence(Timestamp timestamp, CalculatorContext* cc);
+  void OutputSuggestions(Timestamp timestamp, CalculatorContext* cc);
+  // Ends the word and the sentence whose gap since the last letter has
+  // passed at `timestamp`.
+  void FinishExpired(Timestamp timestamp, CalculatorContext* cc);
+
+  // Letter shown by the current input packet, 0 for none.
+  char InputLetter(CalculatorContext* cc) const;
+
+  WordAssemblyCalculatorOptions options_;
+  std::unique_ptr<WordDictionary> dictionary_;
+  // kTextTag or kClassificationTag.
+  const char* input_tag_ = kTextTag;
+  // With CLASSIFICATION, the letter of every classifier output, 0 for labels
+  // that are not letters.
+  std::vector<char> label_letters_;
+
+  // Letter currently shown, 0 for none, since when, and when it was last
+  // added to the word.
+  char letter_ = 0;
+  int64_t letter_start_us_ = 0;
+  int64_t letter_added_us_ = -1;
+  // Last frame showing a letter.
+  int64_t last_letter_us_ = 0;
+  Timestamp last_timestamp_ = Timestamp::Unstarted();
+
+  std::string word_;
+  // Trie node of `word_`, kNoNode once it left the dictionary.
+  WordDictionary::Node word_node_ = WordDictionary::kRoot;
+  std::string sentence_;
+  std::vector<WordDictionary::Node> completions_;
+};
+REGISTER_CALCULATOR(WordAssemblyCalculator);
+
+::mediapipe::Status WordAssemblyCalculator::GetContract(
+    CalculatorContract* cc) {
+  RET_CHECK(cc->Inputs().HasTag(kTextTag) !=
+            cc->Inputs().HasTag(kClassificationTag))
+      << "Use either TEXT or CLASSIFICATION.";
+  if (cc->Inputs().HasTag(kTextTag)) {
+    cc->Inputs().Tag(kTextTag).Set<std::string>();
+  } else {
+    cc->Inputs().Tag(kClassificationTag).Set<GestureClassification>();
+  }
+  if (cc->Outputs().HasTag(kWordTag)) {
+    cc->Outputs().Tag(kWordTag).Set<std::string>();
+  }
+  if (cc->Outputs().HasTag(kSuggestionsTag)) {
+    cc->Outputs().Tag(kSuggestionsTag).Set<std::vector<std::string>>();
+  }
+  if (cc->Outputs().HasTag(kSentenceTag)) {
+    cc->Outputs().Tag(kSentenceTag).Set<std::string>();
+  }
+  // Gaps also expire while the input only advances its timestamp bound.
+  cc->SetProcessTimestampBounds(true);
+  return ::mediapipe::OkStatus();
+}
+
+::mediapipe::Status WordAssemblyCalculator::Open(CalculatorContext* cc) {
+  cc->SetOffset(TimestampDiff(0));
+  options_ = cc->Options<WordAssemblyCalculatorOptions>();
+  RET_CHECK_GE(options_.min_letter_duration_us(), 0);
+  RET_CHECK_GE(options_.letter_repeat_us(), 0);
+  RET_CHECK_GT(options_.word_gap_us(), 0);
+  RET_CHECK_GE(options_.sentence_gap_us(), options_.word_gap_us());
+  if (!options_.dictionary_path().empty()) {
+    ASSIGN_OR_RETURN(dictionary_,
+                     WordDictionary::Open(options_.dictionary_path()));
+  }
+  if (cc->Inputs().HasTag(kClassificationTag)) {
+    input_tag_ = kClassificationTag;
+    std::vector<std::string> labels;
+    MP_RETURN_IF_ERROR(GetGestureLabels(options_.label_map_path(),
+                                        options_.labels(), 0, &labels));
+    for (const std::string& label : labels) {
+      label_letters_.push_back(ToLetter(label));
+    }
+  }
+  word_.reserve(32);
+  completions_.reserve(options_.max_suggestions());
+  return ::mediapipe::OkStatus();
+}
+
+char WordAssemblyCalculator::InputLetter(CalculatorContext* cc) const {
+  if (input_tag_ == kTextTag) {
+    return ToLetter(cc->Inputs().Tag(kTextTag).Get<std::string>());
+  }
+  const auto& classification =
+      cc->Inputs().Tag(kClassificationTag).Get<GestureClassification>();
+  if (classification.label < 0 ||
+      classification.label >= static_cast<int>(label_letters_.size()) ||
+      classification.confidence < options_.min_letter_confidence()) {
+    return 0;
+  }
+  return label_letters_[classification.label];
+}
+
+::mediapipe::Status WordAssemblyCalculator::Process(CalculatorContext* cc) {
+  const Timestamp timestamp = cc->InputTimestamp();
+  if (cc->Inputs().Tag(input_tag_).IsEmpty()) {
+    // Only the timestamp bound moved, e.g. while no hand is in view.
+    if (timestamp.IsRangeValue() && timestamp > last_timestamp_) {
+      last_timestamp_ = timestamp;
+      FinishExpired(timestamp, cc);
+    }
+    return ::mediapipe::OkStatus();
+  }
+  last_timestamp_ = timestamp;
+  const int64_t now_us = timestamp.Microseconds();
+  const char letter = InputLetter(cc);
+
+  const int64_t gap_us = now_us - last_letter_us_;
+  FinishExpired(timestamp, cc);
+  if (letter == 0) {
+    // A letter shown again after a gap is a new letter.
+    letter_ = 0;
+    return ::mediapipe::OkStatus();
+  }
+  if (gap_us >= options_.word_gap_us()) {
+    // No packet in between, e.g. behind HandPresenceGateCalculator: the same
+    // letter after a gap is still a new letter.
+    letter_ = 0;
+  }
+
+  last_letter_us_ = now_us;
+  if (letter != letter_) {
+    letter_ = letter;
+    letter_start_us_ = now_us;
+    letter_added_us_ = -1;
+  }
+  if (letter_added_us_ < 0) {
+    if (now_us - letter_start_us_ >= options_.min_letter_duration_us()) {
+      AddLetter(letter, timestamp, cc);
+      letter_added_us_ = now_us;
+    }
+  } else if (options_.letter_repeat_us() > 0 &&
+             now_us - letter_added_us_ >= options_.letter_repeat_us()) {
+    AddLetter(letter, timestamp, cc);
+    letter_added_us_ = now_us;
+  }
+  return ::mediapipe::OkStatus();
+}
+
+::mediapipe::Status WordAssemblyCalculator::Close(CalculatorContext* cc) {
+  if (last_timestamp_ == Timestamp::Unstarted()) {
+    return ::mediapipe::OkStatus();
+  }
+  const Timestamp timestamp = last_timestamp_.NextAllowedInStream();
+  if (!word_.empty()) {
+    FinishWord(timestamp, cc);
+  }
+  if (!sentence_.empty()) {
+    FinishSentence(timestamp, cc);
+  }
+  return ::mediapipe::OkStatus();
+}
+
+void WordAssemblyCalculator::FinishExpired(Timestamp timestamp,
+                                           CalculatorContext* cc) {
+  const int64_t gap_us = timestamp.Microseconds() - last_letter_us_;
+  if (!word_.empty() && gap_us >= options_.word_gap_us()) {
+    FinishWord(timestamp, cc);
+  }
+  if (!sentence_.empty() && gap_us >= options_.sentence_gap_us()) {
+    FinishSentence(timestamp, cc);
+  }
+}
+
+void WordAssemblyCalculator::AddLetter(char letter, Timestamp timestamp,
+                                       CalculatorContext* cc) {
+  word_.push_back(letter);
+  if (dictionary_) {
+    word_node_ = dictionary_->Child(word_node_, letter);
+  }
+  OutputSuggestions(timestamp, cc);
+}
+
+void WordAssemblyCalculator::FinishWord(Timestamp timestamp,
+                                        CalculatorContext* cc) {
+  std::string word;
+  if (dictionary_ && !dictionary_->IsWord(word_node_) &&
+      options_.max_correction_edits() > 0) {
+    word = dictionary_->WordAt(
+        dictionary_->Correct(word_, options_.max_correction_edits()));
+  }
+  if (word.empty()) {
+    word = word_;
+  }
+  word_.clear();
+  word_node_ = WordDictionary::kRoot;
+  OutputSuggestions(timestamp, cc);
+
+  if (!sentence_.empty()) {
+    sentence_.push_back(' ');
+  }
+  sentence_ += word;
+  if (cc->Outputs().HasTag(kWordTag)) {
+    cc->Outputs().Tag(kWordTag).AddPacket(
+        MakePacket<std::string>(std::move(word)).At(timestamp));
+  }
+}
+
+void WordAssemblyCalculator::FinishSentence(Timestamp timestamp,
+                                            CalculatorContext* cc) {
+  if (cc->Outputs().HasTag(kSentenceTag)) {
+    cc->Outputs().Tag(kSentenceTag).AddPacket(
+        MakePacket<std::string>(sentence_).At(timestamp));
+  }
+  sentence_.clear();
+}
+
+void WordAssemblyCalculator::OutputSuggestions(Timestamp timestamp,
+                                               CalculatorContext* cc) {
+  if (!dictionary_ || !cc->Outputs().HasTag(kSuggestionsTag)) {
+    return;
+  }
+  auto suggestions = absl::make_unique<std::vector<std::string>>();
+  if (!word_.empty()) {
+    dictionary_->Complete(word_node_, options_.max_suggestions(),
+                          &completions_);
+    suggestions->reserve(completions_.size());
+    for (WordDictionary::Node node : completions_) {
+      suggestions->push_back(dictionary_->WordAt(node));
+    }
+  }
+  cc->Outputs().Tag(kSuggestionsTag).Add(suggestions.release(), timestamp);
+}
+
+}  // namespace mediapipe
@@ -0,0 +1,254 @@
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/strings/str_cat.h"
+#include "hand-gesture-recognition/gesture_classification.h"
+#include "hand-gesture-recognition/word_dictionary.h"
+#include "mediapipe/framework/calculator_framework.h"
+#include "mediapipe/framework/calculator_runner.h"
+#include "mediapipe/framework/formats/rect.pb.h"
+#include "mediapipe/framework/port/gtest.h"
+#include "mediapipe/framework/port/parse_text_proto.h"
+#include "mediapipe/framework/port/status_matchers.h"
+#include "mediapipe/framework/tool/sink.h"
+
+namespace mediapipe {
+namespace {
+
+// One frame every 100 ms. With the default options a letter takes three
+// frames after its first to be added, ten to repeat, a word ends seven
+// frames after its last letter and a sentence twenty.
+constexpr int64 kFrameUs = 100000;
+constexpr char kNoHand[] = "No Hand Detected";
+
+// What the recognizer shows, for `num_frames` frames.
+struct Shown {
+  std::string text;
+  int num_frames;
+};
+
+// A calculator on TEXT with all three outputs and `options`.
+CalculatorGraphConfig::Node TextNode(const std::string& options = "") {
+  return ParseTextProtoOrDie<CalculatorGraphConfig::Node>(
+      absl::StrCat(R"(
+        calculator: "WordAssemblyCalculator"
+        input_stream: "TEXT:text"
+        output_stream: "WORD:word"
+        output_stream: "SUGGESTIONS:suggestions"
+        output_stream: "SENTENCE:sentence"
+        node_options: {
+          [type.googleapis.com/mediapipe.WordAssemblyCalculatorOptions] {)",
+                   options, "} }"));
+}
+
+// Feeds `shown` to `runner`, one packet per frame from timestamp 0.
+void AddText(const std::vector<Shown>& shown, CalculatorRunner* runner) {
+  int64 frame = 0;
+  for (const Shown& s : shown) {
+    for (int i = 0; i < s.num_frames; ++i, ++frame) {
+      runner->MutableInputs()->Tag("TEXT").packets.push_back(
+          MakePacket<std::string>(s.text).At(Timestamp(frame * kFrameUs)));
+    }
+  }
+}
+
+// The strings of `packets` with their timestamps.
+std::vector<std::pair<std::string, int64>> Strings(
+    const std::vector<Packet>& packets) {
+  std::vector<std::pair<std::string, int64>> strings;
+  for (const Packet& packet : packets) {
+    strings.emplace_back(packet.Get<std::string>(),
+                         packet.Timestamp().Value());
+  }
+  return strings;
+}
+
+using Timed = std::vector<std::pair<std::string, int64>>;
+
+TEST(WordAssemblyCalculatorTest, SegmentsLettersWordsAndSentences) {
+  CalculatorRunner runner(TextNode());
+  AddText({{"H", 5}, {"I", 5}, {kNoHand, 21}}, &runner);
+  MP_ASSERT_OK(runner.Run());
+
+  // H is added at frame 3, I at frame 8. The word ends seven frames after
+  // the last I, at frame 16, the sentence twenty after it, at frame 29.
+  EXPECT_EQ(Strings(runner.Outputs().Tag("WORD").packets),
+            (Timed{{"HI", 16 * kFrameUs}}));
+  EXPECT_EQ(Strings(runner.Outputs().Tag("SENTENCE").packets),
+            (Timed{{"HI", 29 * kFrameUs}}));
+  // Without a dictionary there are no suggestions.
+  EXPECT_TRUE(runner.Outputs().Tag("SUGGESTIONS").packets.empty());
+}
+
+TEST(WordAssemblyCalculatorTest, ShortLettersAreIgnored) {
+  CalculatorRunner runner(TextNode());
+  // A is shown for 200 ms, B for 300 ms, then C after a frame without a
+  // letter that restarts its duration.
+  AddText({{"A", 3}, {"B", 4}, {"C", 2}, {kNoHand, 1}, {"C", 3}, {kNoHand, 8}},
+          &runner);
+  MP_ASSERT_OK(runner.Run());
+  EXPECT_EQ(Strings(runner.Outputs().Tag("WORD").packets),
+            (Timed{{"B", 19 * kFrameUs}}));
+}
+
+TEST(WordAssemblyCalculatorTest, HeldLettersRepeat) {
+  CalculatorRunner runner(TextNode(R"(letter_repeat_us: 500000)"));
+  // L is added at frame 3 and again at frames 8 and 13.
+  AddText({{"L", 14}, {kNoHand, 7}}, &runner);
+  MP_ASSERT_OK(runner.Run());
+  EXPECT_EQ(Strings(runner.Outputs().Tag("WORD").packets),
+            (Timed{{"LLL", 20 * kFrameUs}}));
+}
+
+TEST(WordAssemblyCalculatorTest, SameLetterAfterAGapIsANewLetter) {
+  CalculatorRunner runner(TextNode(R"(letter_repeat_us: 0)"));
+  // The second O comes after a word gap without any packet in between, as
+  // behind HandPresenceGateCalculator.
+  int64 frame = 0;
+  for (int i = 0; i < 4; ++i, ++frame) {
+    runner.MutableInputs()->Tag("TEXT").packets.push_back(
+        MakePacket<std::string>("O").At(Timestamp(frame * kFrameUs)));
+  }
+  frame += 8;
+  for (int i = 0; i < 4; ++i, ++frame) {
+    runner.MutableInputs()->Tag("TEXT").packets.push_back(
+        MakePacket<std::string>("O").At(Timestamp(frame * kFrameUs)));
+  }
+  MP_ASSERT_OK(runner.Run());
+  // The first word ends when the second O arrives, the second in Close().
+  EXPECT_EQ(Strings(runner.Outputs().Tag("WORD").packets),
+            (Timed{{"O", 12 * kFrameUs}, {"O", 15 * kFrameUs + 1}}));
+  EXPECT_EQ(Strings(runner.Outputs().Tag("SENTENCE").packets),
+            (Timed{{"O O", 15 * kFrameUs + 1}}));
+}
+
+TEST(WordAssemblyCalculatorTest, CloseOutputsThePendingWordAndSentence) {
+  CalculatorRunner runner(TextNode());
+  AddText({{"G", 4}, {"O", 4}}, &runner);
+  MP_ASSERT_OK(runner.Run());
+  EXPECT_EQ(Strings(runner.Outputs().Tag("WORD").packets),
+            (Timed{{"GO", 7 * kFrameUs + 1}}));
+  EXPECT_EQ(Strings(runner.Outputs().Tag("SENTENCE").packets),
+            (Timed{{"GO", 7 * kFrameUs + 1}}));
+}
+
+TEST(WordAssemblyCalculatorTest, ClassificationsNeedConfidence) {
+  CalculatorRunner runner(
+      ParseTextProtoOrDie<CalculatorGraphConfig::Node>(R"(
+        calculator: "WordAssemblyCalculator"
+        input_stream: "CLASSIFICATION:classification"
+        output_stream: "WORD:word"
+        node_options: {
+          [type.googleapis.com/mediapipe.WordAssemblyCalculatorOptions] {
+            labels: "AB"
+            min_letter_confidence: 0.5
+          }
+        })"));
+  // B with enough confidence, then A without, then labels outside `labels`.
+  const std::vector<std::pair<int, float>> frames = {
+      {1, 0.9f}, {1, 0.9f}, {1, 0.6f}, {1, 0.9f}, {0, 0.4f},
+      {0, 0.4f}, {0, 0.4f}, {0, 0.4f}, {5, 0.9f},
+      {GestureClassification::kUnknownLabel, 1.f},
+  };
+  for (int i = 0; i < static_cast<int>(frames.size()); ++i) {
+    GestureClassification classification;
+    classification.label = frames[i].first;
+    classification.confidence = frames[i].second;
+    runner.MutableInputs()->Tag("CLASSIFICATION").packets.push_back(
+        MakePacket<GestureClassification>(classification)
+            .At(Timestamp(i * kFrameUs)));
+  }
+  MP_ASSERT_OK(runner.Run());
+  EXPECT_EQ(Strings(runner.Outputs().Tag("WORD").packets),
+            (Timed{{"B", 9 * kFrameUs + 1}}));
+}
+
+TEST(WordAssemblyCalculatorTest, DictionarySuggestsAndCorrects) {
+  std::string image;
+  MP_ASSERT_OK(BuildWordDictionary(
+      {{"HELLO", 50}, {"HELP", 80}, {"HELD", 10}, {"WORLD", 40}}, &image));
+  const std::string path = ::testing::TempDir() + "/word_assembly.dict";
+  std::ofstream(path, std::ios::binary).write(image.data(), image.size());
+
+  CalculatorRunner runner(TextNode(absl::StrCat(R"(dictionary_path: ")", path,
+                                                R"(" max_suggestions: 2)")));
+  AddText({{"H", 4}, {"E", 4}, {"L", 4}, {"O", 4}, {kNoHand, 7}}, &runner);
+  MP_ASSERT_OK(runner.Run());
+
+  const auto& suggestions = runner.Outputs().Tag("SUGGESTIONS").packets;
+  // One per letter, then an empty one when the word ends.
+  ASSERT_EQ(suggestions.size(), 5u);
+  EXPECT_EQ(suggestions[0].Get<std::vector<std::string>>(),
+            (std::vector<std::string>{"HELP", "HELLO"}));
+  EXPECT_EQ(suggestions[0].Timestamp(), Timestamp(3 * kFrameUs));
+  EXPECT_EQ(suggestions[3].Get<std::vector<std::string>>(),
+            (std::vector<std::string>{}));
+  EXPECT_TRUE(suggestions[4].Get<std::vector<std::string>>().empty());
+  // HELO is one edit from HELD, HELLO and HELP; HELP is the most frequent.
+  EXPECT_EQ(Strings(runner.Outputs().Tag("WORD").packets),
+            (Timed{{"HELP", 22 * kFrameUs}}));
+}
+
+// Behind HandPresenceGateCalculator the frames without a hand only advance
+// the timestamp bound. The word and the sentence still end on time.
+TEST(WordAssemblyCalculatorTest, GapsExpireOnTimestampBoundUpdates) {
+  CalculatorGraphConfig config =
+      ParseTextProtoOrDie<CalculatorGraphConfig>(R"(
+        input_stream: "rect"
+        input_stream: "text"
+        node {
+          calculator: "HandPresenceGateCalculator"
+          input_stream: "NORM_RECT:rect"
+          input_stream: "text"
+          output_stream: "gated_text"
+        }
+        node {
+          calculator: "WordAssemblyCalculator"
+          input_stream: "TEXT:gated_text"
+          output_stream: "WORD:word"
+          output_stream: "SENTENCE:sentence"
+        }
+      )");
+  std::vector<Packet> words;
+  std::vector<Packet> sentences;
+  tool::AddVectorSink("word", &config, &words);
+  tool::AddVectorSink("sentence", &config, &sentences);
+  CalculatorGraph graph;
+  MP_ASSERT_OK(graph.Initialize(config));
+  MP_ASSERT_OK(graph.StartRun({}));
+
+  NormalizedRect hand;
+  hand.set_x_center(0.5f);
+  hand.set_y_center(0.5f);
+  hand.set_width(0.3f);
+  hand.set_height(0.3f);
+  const NormalizedRect no_hand;
+  constexpr int kNumFrames = 40;
+  // One frame at a time, so that every bound update reaches the calculator
+  // on its own.
+  for (int frame = 0; frame < kNumFrames; ++frame) {
+    const Timestamp timestamp(frame * kFrameUs);
+    const bool has_hand = frame < 8;
+    MP_ASSERT_OK(graph.AddPacketToInputStream(
+        "rect", MakePacket<NormalizedRect>(has_hand ? hand : no_hand)
+                    .At(timestamp)));
+    MP_ASSERT_OK(graph.AddPacketToInputStream(
+        "text",
+        MakePacket<std::string>(frame < 4 ? "N" : has_hand ? "O" : kNoHand)
+            .At(timestamp)));
+    MP_ASSERT_OK(graph.WaitUntilIdle());
+  }
+  // Before Close(): the gaps expire with the bounds of the frames.
+  EXPECT_EQ(Strings(words), (Timed{{"NO", 14 * kFrameUs}}));
+  EXPECT_EQ(Strings(sentences), (Timed{{"NO", 27 * kFrameUs}}));
+
+  MP_ASSERT_OK(graph.CloseAllInputStreams());
+  MP_ASSERT_OK(graph.WaitUntilDone());
+  EXPECT_EQ(words.size(), 1u);
+  EXPECT_EQ(sentences.size(), 1u);
+}
+
+}  // namespace
+}  // namespace mediapipe
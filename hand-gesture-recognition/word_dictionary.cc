@@ -0,0 +1,307 @@
+#include "hand-gesture-recognition/word_dictionary.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <queue>
+
+#include "absl/memory/memory.h"
+#include "mediapipe/framework/port/ret_check.h"
+#include "mediapipe/util/resource_util.h"
+
+namespace mediapipe {
+
+namespace {
+
+constexpr int kNumLetters = 26;
+
+struct BuildNode {
+  std::array<int, kNumLetters> children;
+  uint32_t frequency = 0;
+  BuildNode() { children.fill(-1); }
+};
+
+struct Candidate {
+  uint32_t frequency;
+  WordDictionary::Node node;
+  // Stands for every word below `node` rather than the word at `node`.
+  bool subtree;
+};
+
+// Orders the completion queue: higher frequency first, a word before a
+// subtree of the same frequency, then breadth-first order.
+struct CandidateLess {
+  bool operator()(const Candidate& a, const Candidate& b) const {
+    if (a.frequency != b.frequency) return a.frequency < b.frequency;
+    if (a.subtree != b.subtree) return a.subtree;
+    return a.node > b.node;
+  }
+};
+
+}  // namespace
+
+constexpr WordDictionary::Node WordDictionary::kRoot;
+constexpr WordDictionary::Node WordDictionary::kNoNode;
+
+::mediapipe::Status BuildWordDictionary(
+    const std::vector<std::pair<std::string, uint32_t>>& words,
+    std::string* image) {
+  std::vector<BuildNode> trie(1);
+  for (const auto& entry : words) {
+    const std::string& word = entry.first;
+    RET_CHECK(!word.empty()) << "Empty word in the word list.";
+    int node = 0;
+    for (char c : word) {
+      const char letter = c >= 'a' && c <= 'z' ? c - 'a' + 'A' : c;
+      RET_CHECK(letter >= 'A' && letter <= 'Z')
+          << "\"" << word << "\" has other characters than letters.";
+      int& child = trie[node].children[letter - 'A'];
+      if (child < 0) {
+        child = trie.size();
+        trie.emplace_back();
+      }
+      node = trie[node].children[letter - 'A'];
+    }
+    trie[node].frequency += std::max<uint32_t>(entry.second, 1);
+  }
+
+  // Breadth-first numbering puts the children of every node next to each
+  // other, in letter order.
+  std::vector<WordDictionaryNode> nodes(trie.size());
+  std::vector<int> order;
+  order.reserve(trie.size());
+  order.push_back(0);
+  nodes[0] = WordDictionaryNode();
+  nodes[0].parent = WordDictionary::kNoNode;
+  for (int i = 0; i < static_cast<int>(order.size()); ++i) {
+    const BuildNode& source = trie[order[i]];
+    WordDictionaryNode& node = nodes[i];
+    node.frequency = source.frequency;
+    node.first_child = order.size();
+    node.num_children = 0;
+    for (int letter = 0; letter < kNumLetters; ++letter) {
+      if (source.children[letter] < 0) continue;
+      WordDictionaryNode& child = nodes[order.size()];
+      child.parent = i;
+      child.letter = 'A' + letter;
+      RET_CHECK_LT(node.depth, 0xffff) << "Word too long.";
+      child.depth = node.depth + 1;
+      order.push_back(source.children[letter]);
+      ++node.num_children;
+    }
+  }
+
+  // Children come after their parent, so one backward pass sees every
+  // subtree complete.
+  for (int i = nodes.size() - 1; i >= 0; --i) {
+    WordDictionaryNode& node = nodes[i];
+    node.best_word = node.frequency > 0 ? i : WordDictionary::kNoNode;
+    uint32_t best_frequency = node.frequency;
+    for (int c = 0; c < node.num_children; ++c) {
+      const uint32_t child_best = nodes[node.first_child + c].best_word;
+      if (child_best != WordDictionary::kNoNode &&
+          nodes[child_best].frequency > best_frequency) {
+        node.best_word = child_best;
+        best_frequency = nodes[child_best].frequency;
+      }
+    }
+  }
+
+  WordDictionaryHeader header;
+  std::memcpy(header.magic, kWordDictionaryMagic, sizeof(header.magic));
+  header.version = kWordDictionaryVersion;
+  header.node_size = sizeof(WordDictionaryNode);
+  header.num_nodes = nodes.size();
+  image->resize(sizeof(header) + nodes.size() * sizeof(WordDictionaryNode));
+  std::memcpy(&(*image)[0], &header, sizeof(header));
+  std::memcpy(&(*image)[sizeof(header)], nodes.data(),
+              nodes.size() * sizeof(WordDictionaryNode));
+  return ::mediapipe::OkStatus();
+}
+
+::mediapipe::StatusOr<std::unique_ptr<WordDictionary>> WordDictionary::Open(
+    const std::string& path) {
+  std::string resolved_path;
+  ASSIGN_OR_RETURN(resolved_path, PathToResourceAsFile(path));
+
+  const int fd = open(resolved_path.c_str(), O_RDONLY);
+  RET_CHECK_GE(fd, 0) << "Failed to open " << resolved_path;
+  struct stat file_stat;
+  const bool stat_ok = fstat(fd, &file_stat) == 0;
+  void* mapping = MAP_FAILED;
+  if (stat_ok && file_stat.st_size > 0) {
+    mapping = mmap(nullptr, file_stat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  }
+  // The mapping stays valid once the file is closed.
+  close(fd);
+  RET_CHECK(mapping != MAP_FAILED) << "Failed to map " << resolved_path;
+
+  auto dictionary = absl::WrapUnique(new WordDictionary());
+  dictionary->mapping_ = mapping;
+  dictionary->mapping_size_ = file_stat.st_size;
+
+  RET_CHECK_GE(dictionary->mapping_size_, sizeof(WordDictionaryHeader))
+      << resolved_path << " is not a word dictionary.";
+  const auto* header = static_cast<const WordDictionaryHeader*>(mapping);
+  RET_CHECK(std::memcmp(header->magic, kWordDictionaryMagic,
+                        sizeof(header->magic)) == 0)
+      << resolved_path << " is not a word dictionary.";
+  RET_CHECK_EQ(header->version, kWordDictionaryVersion);
+  RET_CHECK_EQ(header->node_size, sizeof(WordDictionaryNode));
+  RET_CHECK_GT(header->num_nodes, 0u);
+  RET_CHECK_EQ(dictionary->mapping_size_,
+               sizeof(WordDictionaryHeader) +
+                   size_t{header->num_nodes} * sizeof(WordDictionaryNode))
+      << resolved_path << " is truncated.";
+
+  const auto* nodes = reinterpret_cast<const WordDictionaryNode*>(header + 1);
+  const uint32_t num_nodes = header->num_nodes;
+  // Checked once here so that lookups can trust every index.
+  for (uint32_t i = 0; i < num_nodes; ++i) {
+    const WordDictionaryNode& node = nodes[i];
+    RET_CHECK(node.num_children == 0 ||
+              (node.first_child > i && node.first_child < num_nodes &&
+               node.num_children <= num_nodes - node.first_child))
+        << "Corrupt children at node " << i;
+    for (int c = 0; c < node.num_children; ++c) {
+      RET_CHECK_EQ(nodes[node.first_child + c].parent, i)
+          << "Corrupt children at node " << i;
+    }
+    RET_CHECK(i == kRoot ? node.parent == kNoNode : node.parent < i)
+        << "Corrupt parent at node " << i;
+    // WordAt and CorrectBelow size and index their buffers by depth.
+    RET_CHECK_EQ(node.depth, i == kRoot ? 0 : nodes[node.parent].depth + 1)
+        << "Corrupt depth at node " << i;
+    RET_CHECK(node.best_word == kNoNode ||
+              (node.best_word < num_nodes &&
+               nodes[node.best_word].frequency > 0))
+        << "Corrupt completion at node " << i;
+  }
+  dictionary->nodes_ = nodes;
+  dictionary->num_nodes_ = num_nodes;
+  return dictionary;
+}
+
+WordDictionary::~WordDictionary() {
+  if (mapping_ != nullptr) {
+    munmap(mapping_, mapping_size_);
+  }
+}
+
+WordDictionary::Node WordDictionary::Child(Node node, char letter) const {
+  if (node == kNoNode) return kNoNode;
+  const WordDictionaryNode& parent = nodes_[node];
+  for (int c = 0; c < parent.num_children; ++c) {
+    const Node child = parent.first_child + c;
+    if (nodes_[child].letter == letter) return child;
+    // Children are sorted by letter.
+    if (nodes_[child].letter > letter) break;
+  }
+  return kNoNode;
+}
+
+WordDictionary::Node WordDictionary::Find(const std::string& prefix) const {
+  Node node = kRoot;
+  for (char letter : prefix) {
+    node = Child(node, letter);
+  }
+  return node;
+}
+
+void WordDictionary::Complete(Node node, int max_results,
+                              std::vector<Node>* results) const {
+  results->clear();
+  if (node == kNoNode || nodes_[node].best_word == kNoNode) return;
+
+  // Best-first search. A subtree is queued with the frequency of its best
+  // word, an upper bound for all its words, so words come out in order and
+  // only the branches leading to the top results are expanded.
+  std::priority_queue<Candidate, std::vector<Candidate>, CandidateLess> queue;
+  queue.push({frequency(nodes_[node].best_word), node, true});
+  while (!queue.empty() && static_cast<int>(results->size()) < max_results) {
+    const Candidate candidate = queue.top();
+    queue.pop();
+    if (!candidate.subtree) {
+      results->push_back(candidate.node);
+      continue;
+    }
+    const WordDictionaryNode& subtree = nodes_[candidate.node];
+    if (subtree.frequency > 0) {
+      queue.push({subtree.frequency, candidate.node, false});
+    }
+    for (int c = 0; c < subtree.num_children; ++c) {
+      const Node child = subtree.first_child + c;
+      if (nodes_[child].best_word != kNoNode) {
+        queue.push({frequency(nodes_[child].best_word), child, true});
+      }
+    }
+  }
+}
+
+WordDictionary::Node WordDictionary::Correct(const std::string& word,
+                                             int max_edits) const {
+  const int width = word.size() + 1;
+  // One edit distance row per depth, as in a Levenshtein matrix whose rows
+  // are shared by every word with the same prefix.
+  std::vector<int> rows((word.size() + max_edits + 1) * width);
+  for (int j = 0; j < width; ++j) rows[j] = j;
+
+  Node best = kNoNode;
+  int best_distance = max_edits + 1;
+  if (IsWord(kRoot) && static_cast<int>(word.size()) <= max_edits) {
+    best = kRoot;
+    best_distance = word.size();
+  }
+  CorrectBelow(kRoot, word, max_edits, &rows, &best, &best_distance);
+  return best;
+}
+
+void WordDictionary::CorrectBelow(Node node, const std::string& word,
+                                  int max_edits, std::vector<int>* rows,
+                                  Node* best, int* best_distance) const {
+  const int width = word.size() + 1;
+  const WordDictionaryNode& parent = nodes_[node];
+  if (parent.depth + 1 > static_cast<int>(word.size()) + max_edits) return;
+  const int* previous = rows->data() + parent.depth * width;
+  int* row = rows->data() + (parent.depth + 1) * width;
+  for (int c = 0; c < parent.num_children; ++c) {
+    const Node child = parent.first_child + c;
+    const char letter = nodes_[child].letter;
+    row[0] = parent.depth + 1;
+    int row_min = row[0];
+    for (int j = 1; j < width; ++j) {
+      row[j] = std::min({previous[j] + 1, row[j - 1] + 1,
+                         previous[j - 1] + (word[j - 1] != letter)});
+      row_min = std::min(row_min, row[j]);
+    }
+    const int distance = row[width - 1];
+    if (nodes_[child].frequency > 0 &&
+        (distance < *best_distance ||
+         (distance == *best_distance && *best != kNoNode &&
+          nodes_[child].frequency > nodes_[*best].frequency))) {
+      *best = child;
+      *best_distance = distance;
+    }
+    // Every word below is at least `row_min` edits away.
+    if (row_min <= max_edits) {
+      CorrectBelow(child, word, max_edits, rows, best, best_distance);
+    }
+  }
+}
+
+std::string WordDictionary::WordAt(Node node) const {
+  if (node == kNoNode) return std::string();
+  std::string word(nodes_[node].depth, ' ');
+  for (int i = word.size() - 1; i >= 0; --i) {
+    word[i] = nodes_[node].letter;
+    node = nodes_[node].parent;
+  }
+  return word;
+}
+
+}  // namespace mediapipe
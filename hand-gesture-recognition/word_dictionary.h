@@ -0,0 +1,118 @@
+#ifndef HAND_GESTURE_RECOGNITION_WORD_DICTIONARY_H_
+#define HAND_GESTURE_RECOGNITION_WORD_DICTIONARY_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "mediapipe/framework/port/status.h"
+#include "mediapipe/framework/port/statusor.h"
+
+namespace mediapipe {
+
+// Compact trie of A-Z words with their frequencies, built offline by
+// build_word_dictionary and memory-mapped read-only at runtime.
+//
+// A dictionary file is a WordDictionaryHeader followed by the nodes, in
+// native byte order. Node 0 is the root. Nodes are stored breadth first, so
+// the children of a node are contiguous and sorted by letter: finding a child
+// scans at most 26 nodes, and following a word of n letters costs O(n)
+// whatever the size of the dictionary. Every node knows the most frequent
+// word below it, which makes the best completion of a prefix O(1).
+
+constexpr char kWordDictionaryMagic[4] = {'H', 'G', 'W', 'D'};
+constexpr uint32_t kWordDictionaryVersion = 1;
+
+struct WordDictionaryHeader {
+  char magic[4];
+  uint32_t version;
+  uint32_t node_size;
+  uint32_t num_nodes;
+};
+
+struct WordDictionaryNode {
+  uint32_t first_child;
+  uint32_t parent;
+  // Zero when no word ends here.
+  uint32_t frequency;
+  // Node of the most frequent word in this subtree, itself included.
+  uint32_t best_word;
+  char letter;
+  uint8_t num_children;
+  uint16_t depth;
+};
+
+static_assert(sizeof(WordDictionaryHeader) == 16,
+              "Unexpected header padding.");
+static_assert(sizeof(WordDictionaryNode) == 20, "Unexpected node padding.");
+
+// Serializes `words` (word, frequency) into a dictionary image. Words are
+// upper-cased; words with other characters than letters are rejected.
+// Duplicates add up their frequencies.
+::mediapipe::Status BuildWordDictionary(
+    const std::vector<std::pair<std::string, uint32_t>>& words,
+    std::string* image);
+
+class WordDictionary {
+ public:
+  using Node = uint32_t;
+  static constexpr Node kRoot = 0;
+  static constexpr Node kNoNode = 0xffffffff;
+
+  // Maps the dictionary found at `path` (resolved with PathToResourceAsFile).
+  static ::mediapipe::StatusOr<std::unique_ptr<WordDictionary>> Open(
+      const std::string& path);
+  ~WordDictionary();
+
+  WordDictionary(const WordDictionary&) = delete;
+  WordDictionary& operator=(const WordDictionary&) = delete;
+
+  // Node of the prefix of `node` followed by `letter`, kNoNode if no word
+  // starts with it. kNoNode stays kNoNode.
+  Node Child(Node node, char letter) const;
+
+  // Node of `prefix`, kNoNode if no word starts with it.
+  Node Find(const std::string& prefix) const;
+
+  bool IsWord(Node node) const {
+    return node != kNoNode && nodes_[node].frequency > 0;
+  }
+  uint32_t frequency(Node node) const { return nodes_[node].frequency; }
+
+  // Most frequent word starting with the prefix of `node`, kNoNode if none.
+  Node BestCompletion(Node node) const {
+    return node == kNoNode ? kNoNode : nodes_[node].best_word;
+  }
+
+  // Up to `max_results` words starting with the prefix of `node`, most
+  // frequent first.
+  void Complete(Node node, int max_results, std::vector<Node>* results) const;
+
+  // Most frequent word at most `max_edits` insertions, deletions or
+  // substitutions away from `word`, closest first. kNoNode if none.
+  Node Correct(const std::string& word, int max_edits) const;
+
+  // The word, or prefix, ending at `node`.
+  std::string WordAt(Node node) const;
+
+  int num_nodes() const { return num_nodes_; }
+
+ private:
+  WordDictionary() = default;
+
+  void CorrectBelow(Node node, const std::string& word, int max_edits,
+                    std::vector<int>* rows, Node* best,
+                    int* best_distance) const;
+
+  void* mapping_ = nullptr;
+  size_t mapping_size_ = 0;
+  const WordDictionaryNode* nodes_ = nullptr;
+  int num_nodes_ = 0;
+};
+
+}  // namespace mediapipe
+
+#endif  // HAND_GESTURE_RECOGNITION_WORD_DICTIONARY_H_
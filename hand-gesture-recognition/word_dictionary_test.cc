@@ -0,0 +1,174 @@
+#include "hand-gesture-recognition/word_dictionary.h"
+
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "mediapipe/framework/port/gtest.h"
+#include "mediapipe/framework/port/status_matchers.h"
+
+namespace mediapipe {
+namespace {
+
+const std::vector<std::pair<std::string, uint32_t>>& TestWords() {
+  static const auto* words =
+      new std::vector<std::pair<std::string, uint32_t>>{
+          {"HELLO", 50}, {"HELP", 80}, {"HELD", 10}, {"HE", 30},
+          {"hello", 5},  {"WORLD", 40}, {"WORD", 60}, {"A", 100},
+      };
+  return *words;
+}
+
+std::string WriteImage(const std::string& name, const std::string& image) {
+  const std::string path = ::testing::TempDir() + "/" + name;
+  std::ofstream file(path, std::ios::binary);
+  file.write(image.data(), image.size());
+  return path;
+}
+
+std::string BuildImage() {
+  std::string image;
+  EXPECT_TRUE(BuildWordDictionary(TestWords(), &image).ok());
+  return image;
+}
+
+std::unique_ptr<WordDictionary> OpenImage(const std::string& name,
+                                          const std::string& image) {
+  auto dictionary = WordDictionary::Open(WriteImage(name, image));
+  MP_EXPECT_OK(dictionary.status());
+  if (!dictionary.ok()) return nullptr;
+  return std::move(dictionary).ValueOrDie();
+}
+
+// Node `i` of a dictionary image, for corrupting it.
+WordDictionaryNode* MutableNode(std::string* image, int i) {
+  return reinterpret_cast<WordDictionaryNode*>(
+      &(*image)[sizeof(WordDictionaryHeader) + i * sizeof(WordDictionaryNode)]);
+}
+
+TEST(WordDictionaryTest, BuildRejectsOtherCharactersThanLetters) {
+  std::string image;
+  EXPECT_FALSE(BuildWordDictionary({{"HI5", 1}}, &image).ok());
+  EXPECT_FALSE(BuildWordDictionary({{"", 1}}, &image).ok());
+}
+
+TEST(WordDictionaryTest, FindsWordsAndPrefixes) {
+  auto dictionary = OpenImage("find.dict", BuildImage());
+  ASSERT_NE(dictionary, nullptr);
+
+  const WordDictionary::Node hello = dictionary->Find("HELLO");
+  ASSERT_NE(hello, WordDictionary::kNoNode);
+  EXPECT_TRUE(dictionary->IsWord(hello));
+  // Words are upper-cased and duplicates add up.
+  EXPECT_EQ(dictionary->frequency(hello), 55u);
+  EXPECT_EQ(dictionary->WordAt(hello), "HELLO");
+
+  const WordDictionary::Node hel = dictionary->Find("HEL");
+  ASSERT_NE(hel, WordDictionary::kNoNode);
+  EXPECT_FALSE(dictionary->IsWord(hel));
+  EXPECT_EQ(dictionary->WordAt(hel), "HEL");
+  EXPECT_EQ(dictionary->Child(hel, 'P'), dictionary->Find("HELP"));
+
+  EXPECT_EQ(dictionary->Find("HELLOS"), WordDictionary::kNoNode);
+  EXPECT_EQ(dictionary->Find("X"), WordDictionary::kNoNode);
+  EXPECT_EQ(dictionary->Child(WordDictionary::kNoNode, 'A'),
+            WordDictionary::kNoNode);
+  EXPECT_FALSE(dictionary->IsWord(WordDictionary::kNoNode));
+  EXPECT_EQ(dictionary->WordAt(WordDictionary::kRoot), "");
+}
+
+TEST(WordDictionaryTest, CompletesMostFrequentFirst) {
+  auto dictionary = OpenImage("complete.dict", BuildImage());
+  ASSERT_NE(dictionary, nullptr);
+
+  const WordDictionary::Node he = dictionary->Find("HE");
+  EXPECT_EQ(dictionary->WordAt(dictionary->BestCompletion(he)), "HELP");
+
+  std::vector<WordDictionary::Node> results;
+  dictionary->Complete(he, 10, &results);
+  std::vector<std::string> words;
+  for (WordDictionary::Node node : results) {
+    words.push_back(dictionary->WordAt(node));
+  }
+  EXPECT_EQ(words, (std::vector<std::string>{"HELP", "HELLO", "HE", "HELD"}));
+
+  dictionary->Complete(he, 2, &results);
+  ASSERT_EQ(results.size(), 2u);
+  EXPECT_EQ(dictionary->WordAt(results[1]), "HELLO");
+
+  dictionary->Complete(dictionary->Find("Q"), 10, &results);
+  EXPECT_TRUE(results.empty());
+  EXPECT_EQ(dictionary->BestCompletion(WordDictionary::kNoNode),
+            WordDictionary::kNoNode);
+}
+
+TEST(WordDictionaryTest, CorrectsWithinMaxEdits) {
+  auto dictionary = OpenImage("correct.dict", BuildImage());
+  ASSERT_NE(dictionary, nullptr);
+
+  auto correct = [&](const std::string& word, int max_edits) {
+    return dictionary->WordAt(dictionary->Correct(word, max_edits));
+  };
+  EXPECT_EQ(correct("HELLO", 0), "HELLO");
+  // Substitution, deletion and insertion.
+  EXPECT_EQ(correct("WPRLD", 1), "WORLD");
+  EXPECT_EQ(correct("WRLD", 1), "WORLD");
+  EXPECT_EQ(correct("HELLLO", 1), "HELLO");
+  // HELD, HELP and HELLO are one edit from HELO; HELP is the most frequent.
+  EXPECT_EQ(correct("HELO", 1), "HELP");
+  // The closest word wins over a more frequent one further away.
+  EXPECT_EQ(correct("WORLE", 2), "WORLD");
+  EXPECT_EQ(dictionary->Correct("QQQQQ", 2), WordDictionary::kNoNode);
+  EXPECT_EQ(dictionary->Correct("WPRLD", 0), WordDictionary::kNoNode);
+}
+
+TEST(WordDictionaryTest, RejectsCorruptFiles) {
+  const std::string image = BuildImage();
+  const int num_nodes = (image.size() - sizeof(WordDictionaryHeader)) /
+                        sizeof(WordDictionaryNode);
+  const WordDictionary::Node help =
+      OpenImage("valid.dict", image)->Find("HELP");
+
+  const std::vector<std::pair<std::string,
+                              std::function<void(std::string*)>>>
+      corruptions = {
+          {"empty", [](std::string* image) { image->clear(); }},
+          {"magic", [](std::string* image) { (*image)[0] = 'X'; }},
+          {"truncated",
+           [](std::string* image) { image->resize(image->size() - 1); }},
+          {"first_child",
+           [](std::string* image) {
+             MutableNode(image, 0)->first_child = 0xffffffff;
+           }},
+          {"parent",
+           [](std::string* image) { MutableNode(image, 1)->parent = 1; }},
+          {"child_parent",
+           [](std::string* image) { MutableNode(image, 2)->parent = 1; }},
+          {"depth",
+           [help](std::string* image) {
+             MutableNode(image, help)->depth = 0x7fff;
+           }},
+          {"root_depth",
+           [](std::string* image) { MutableNode(image, 0)->depth = 3; }},
+          {"best_word_range",
+           [num_nodes](std::string* image) {
+             MutableNode(image, 0)->best_word = num_nodes;
+           }},
+          {"best_word_frequency",
+           [](std::string* image) { MutableNode(image, 1)->best_word = 0; }},
+      };
+  for (const auto& corruption : corruptions) {
+    std::string corrupt = image;
+    corruption.second(&corrupt);
+    EXPECT_FALSE(
+        WordDictionary::Open(WriteImage(corruption.first + ".dict", corrupt))
+            .ok())
+        << corruption.first;
+  }
+}
+
+}  // namespace
+}  // namespace mediapipe